@@ -0,0 +1,110 @@
+/**
+ * @file bench_concurrent_map.c
+ * @brief Throughput of concurrent_map_t vs thread count for read-heavy and write-heavy mixes
+ *
+ * The map is prefilled with the whole key space, then every thread runs the same number of
+ * random operations: a get, or a put that replaces an existing key. One shard stands in for a
+ * single global lock. Threads double from 1 up to the requested maximum.
+ *
+ * Usage: bench_concurrent_map [operations per thread] [max threads]
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "bench_utils.h"
+#include "concurrent_map.h"
+
+#include <pthread.h>
+
+#define BENCH_DEFAULT_OPS     1000000U
+#define BENCH_DEFAULT_THREADS 16U
+#define BENCH_KEY_SPACE       (1U << 20)
+#define BENCH_LCG_MUL         6364136223846793005ULL
+#define BENCH_LCG_ADD         1442695040888963407ULL
+
+typedef struct bench_worker_t
+{
+    concurrent_map_t  *map;
+    size_t             ops;
+    unsigned           write_percent;
+    unsigned long long seed;
+} bench_worker_t;
+
+static u32_t bench_next(unsigned long long *state)
+{
+    *state = *state * BENCH_LCG_MUL + BENCH_LCG_ADD;
+    return (u32_t) (*state >> 33U);
+}
+
+static void *bench_worker(void *arg)
+{
+    bench_worker_t    *worker = arg;
+    unsigned long long state  = worker->seed;
+    for (size_t i = 0; i < worker->ops; i++)
+    {
+        u32_t key = bench_next(&state) % BENCH_KEY_SPACE;
+        if (bench_next(&state) % 100U < worker->write_percent)
+        {
+            cmap_put(worker->map, key, malloc(sizeof(size_t)));
+        }
+        else
+        {
+            cmap_get(worker->map, key, NULL, NULL);
+        }
+    }
+    return NULL;
+}
+
+static void bench_mix(size_t shards, unsigned write_percent, size_t ops, size_t threads)
+{
+    concurrent_map_t *map = cmap_init(shards);
+    for (u32_t key = 0; key < BENCH_KEY_SPACE; key++)
+    {
+        cmap_put(map, key, malloc(sizeof(size_t)));
+    }
+
+    pthread_t      *ids     = malloc(threads * sizeof(pthread_t));
+    bench_worker_t *workers = malloc(threads * sizeof(bench_worker_t));
+    check_mem_alloc(ids, "Bench threads");
+    check_mem_alloc(workers, "Bench workers");
+
+    double start = bench_now();
+    for (size_t t = 0; t < threads; t++)
+    {
+        workers[t] = (bench_worker_t) {map, ops, write_percent, t + 1};
+        pthread_create(&ids[t], NULL, bench_worker, &workers[t]);
+    }
+    for (size_t t = 0; t < threads; t++)
+    {
+        pthread_join(ids[t], NULL);
+    }
+
+    char label[64];
+    snprintf(label, sizeof(label), "%3zu shards %2u%% writes %2zu threads",
+             cmap_shard_count(map), write_percent, threads);
+    bench_report(label, ops * threads, bench_now() - start);
+
+    free(workers);
+    free(ids);
+    cmap_destroy(map);
+}
+
+int main(int argc, char **argv)
+{
+    size_t   ops            = bench_arg_count(argc, argv, 1, BENCH_DEFAULT_OPS);
+    size_t   max_threads    = bench_arg_count(argc, argv, 2, BENCH_DEFAULT_THREADS);
+    size_t   shard_counts[] = {1, CMAP_DEFAULT_SHARDS};
+    unsigned mixes[]        = {5, 50};
+
+    for (size_t m = 0; m < sizeof(mixes) / sizeof(mixes[0]); m++)
+    {
+        for (size_t s = 0; s < sizeof(shard_counts) / sizeof(shard_counts[0]); s++)
+        {
+            for (size_t threads = 1; threads <= max_threads; threads *= 2)
+            {
+                bench_mix(shard_counts[s], mixes[m], ops, threads);
+            }
+        }
+    }
+    return EXIT_SUCCESS;
+}
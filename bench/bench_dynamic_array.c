@@ -0,0 +1,89 @@
+/**
+ * @file bench_dynamic_array.c
+ * @brief Append throughput of dynamic_array_t at growing sizes
+ *
+ * With geometric growth the ns/op column stays flat from 10^4 to 10^7 elements,
+ * with the old +2 growth it grew linearly with n.
+ *
+ * The second part inserts a batch in the middle of a large array, element by element with
+ * dynarray_set and in one shot with dynarray_insert_range.
+ *
+ * Usage: bench_dynamic_array [max_elements]
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "bench_utils.h"
+#include "dynamic_array.h"
+
+#define BENCH_DEFAULT_MAX 10000000U
+#define BENCH_MIN_COUNT   10000U
+#define BENCH_STEP        10U
+#define BENCH_BASE_SIZE   1000000U
+#define BENCH_BATCH_SIZE  1000U
+
+static int s_payload;
+
+static void bench_push(size_t count, bool reserve)
+{
+    dynamic_array_t *arr = dynarray_init();
+    if (reserve)
+    {
+        dynarray_reserve(arr, count);
+    }
+    double start = bench_now();
+    for (size_t i = 0; i < count; i++)
+    {
+        dynarray_push(arr, &s_payload);
+    }
+    double elapsed = bench_now() - start;
+
+    char label[64];
+    snprintf(label, sizeof(label), "dynarray_push%s n=%zu", reserve ? " (reserved)" : "", count);
+    bench_report(label, count, elapsed);
+    dynarray_destroy(arr);
+}
+
+static void bench_middle_insert(bool batched)
+{
+    dynamic_array_t *arr = dynarray_init_with_capacity(BENCH_BASE_SIZE + BENCH_BATCH_SIZE);
+    for (size_t i = 0; i < BENCH_BASE_SIZE; i++)
+    {
+        dynarray_push(arr, &s_payload);
+    }
+    void *batch[BENCH_BATCH_SIZE];
+    for (size_t i = 0; i < BENCH_BATCH_SIZE; i++)
+    {
+        batch[i] = &s_payload;
+    }
+
+    double start = bench_now();
+    if (batched)
+    {
+        dynarray_insert_range(arr, BENCH_BASE_SIZE / 2, batch, BENCH_BATCH_SIZE);
+    }
+    else
+    {
+        for (size_t i = 0; i < BENCH_BATCH_SIZE; i++)
+        {
+            dynarray_set(arr, BENCH_BASE_SIZE / 2 + i, batch[i]);
+        }
+    }
+    bench_report(batched ? "middle insert, dynarray_insert_range" : "middle insert, dynarray_set x N",
+                 BENCH_BATCH_SIZE,
+                 bench_now() - start);
+    dynarray_destroy(arr);
+}
+
+int main(int argc, char **argv)
+{
+    size_t max_count = bench_arg_count(argc, argv, 1, BENCH_DEFAULT_MAX);
+    for (size_t count = BENCH_MIN_COUNT; count <= max_count; count *= BENCH_STEP)
+    {
+        bench_push(count, false);
+        bench_push(count, true);
+    }
+    bench_middle_insert(false);
+    bench_middle_insert(true);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,114 @@
+/**
+ * @file bench_hash.c
+ * @brief Hashing throughput in GB/s per key length, and string-keyed map lookups per hash
+ *
+ * Every length hashes about the same number of bytes so short keys measure per call overhead
+ * and long keys measure the inner loop.
+ *
+ * Usage: bench_hash [megabytes per length] [map entries]
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "bench_utils.h"
+#include "hash.h"
+#include "hash_map.h"
+
+#include <string.h>
+
+#define BENCH_DEFAULT_MEGABYTES 256U
+#define BENCH_DEFAULT_ENTRIES   500000U
+#define BENCH_BYTES_PER_MB      1000000U
+#define BENCH_KEY_BUFFER        32
+
+typedef struct bench_hash_t
+{
+    const char *name;
+    hash_fn_t   hash;
+} bench_hash_t;
+
+static const bench_hash_t s_hashes[] = {
+    {"fnv1a", hash_fnv1a},
+    {"djb2", hash_djb2},
+    {"murmur64a", hash_murmur64a},
+};
+
+static volatile u64_t s_sink;
+
+static void bench_throughput(const bench_hash_t *hash, const byte_t *data, size_t len,
+                             size_t total_bytes)
+{
+    size_t calls = total_bytes / len;
+    u64_t  acc   = 0;
+    double start = bench_now();
+    for (size_t i = 0; i < calls; i++)
+    {
+        // Feed the previous result back as seed so calls cannot be hoisted or overlapped away
+        acc = hash->hash(data, len, acc);
+    }
+    double seconds = bench_now() - start;
+    s_sink         = acc;
+    printf("%-10s %8zu B keys  %8.3f GB/s  %8.2f ns/hash\n", hash->name, len,
+           (double) (calls * len) / seconds / 1e9, seconds * BENCH_NS_PER_SEC / (double) calls);
+}
+
+static size_t bench_key(char *buffer, size_t i)
+{
+    return (size_t) snprintf(buffer, BENCH_KEY_BUFFER, "user:%zu:session", i * 2654435761U);
+}
+
+static void bench_map(const bench_hash_t *hash, size_t entries)
+{
+    hash_map_bytes_t *map = init_hash_map_bytes(hash->hash, 0);
+    char              key[BENCH_KEY_BUFFER];
+    char              label[64];
+
+    double start = bench_now();
+    for (size_t i = 0; i < entries; i++)
+    {
+        size_t *payload = malloc(sizeof(size_t));
+        check_mem_alloc(payload, "Bench payload");
+        add_entry_bytes(map, key, bench_key(key, i), payload);
+    }
+    snprintf(label, sizeof(label), "hash_map_bytes_t %s put", hash->name);
+    bench_report(label, entries, bench_now() - start);
+
+    size_t found = 0;
+    start        = bench_now();
+    for (size_t i = 0; i < entries; i++)
+    {
+        found += get_entry_bytes(map, key, bench_key(key, i)) != NULL;
+    }
+    snprintf(label, sizeof(label), "hash_map_bytes_t %s get", hash->name);
+    bench_report(label, found, bench_now() - start);
+    delete_hash_map_bytes(map);
+}
+
+int main(int argc, char **argv)
+{
+    size_t total   = bench_arg_count(argc, argv, 1, BENCH_DEFAULT_MEGABYTES) * BENCH_BYTES_PER_MB;
+    size_t entries = bench_arg_count(argc, argv, 2, BENCH_DEFAULT_ENTRIES);
+    size_t lengths[] = {8, 32, 256, 4096, 1U << 20};
+    size_t hashes    = sizeof(s_hashes) / sizeof(s_hashes[0]);
+
+    byte_t *data = malloc(lengths[4]);
+    check_mem_alloc(data, "Bench data");
+    for (size_t i = 0; i < lengths[4]; i++)
+    {
+        data[i] = (byte_t) (i * 131U);
+    }
+
+    for (size_t h = 0; h < hashes; h++)
+    {
+        for (size_t l = 0; l < sizeof(lengths) / sizeof(lengths[0]); l++)
+        {
+            bench_throughput(&s_hashes[h], data, lengths[l], total);
+        }
+    }
+    for (size_t h = 0; h < hashes; h++)
+    {
+        bench_map(&s_hashes[h], entries);
+    }
+    free(data);
+    return EXIT_SUCCESS;
+}
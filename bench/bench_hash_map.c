@@ -0,0 +1,259 @@
+/**
+ * @file bench_hash_map.c
+ * @brief Put, hit, miss, remove and iterate: separate chaining, Robin Hood open addressing,
+ * control-byte group probing and the dense insertion-ordered map
+ *
+ * Keys are scrambled integers so neither table sees a sequential pattern. Payloads are
+ * allocated before the timed loops, every map frees them on remove and delete.
+ *
+ * Build with EXTRA flags such as -mavx2 to compare 32-wide groups against the SSE2 default.
+ *
+ * Usage: bench_hash_map [entries]
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "bench_utils.h"
+#include "hash_map.h"
+
+#define BENCH_DEFAULT_ENTRIES 1000000U
+#define BENCH_KEY_MUL         2654435761U // Odd, so i -> i * BENCH_KEY_MUL is a bijection
+#define BENCH_MISS_OFFSET     0x80000000U
+
+typedef struct bench_map_ops_t
+{
+    const char *name;
+    void *(*init)(void);
+    void (*put)(void *map, u32_t key, void *data);
+    void *(*get)(const void *map, u32_t key);
+    bool (*remove)(void *map, u32_t key);
+    void (*for_each)(const void *map, hash_map_visit_t visit, void *ctx);
+    void (*destroy)(void *map);
+} bench_map_ops_t;
+
+static void *sc_init(void)
+{
+    return init_hash_map();
+}
+
+static void sc_put(void *map, u32_t key, void *data)
+{
+    add_entry_sc(map, key, data);
+}
+
+static void *sc_get(const void *map, u32_t key)
+{
+    return get_entry_sc(map, key);
+}
+
+static bool sc_remove(void *map, u32_t key)
+{
+    return remove_entry_sc(map, key);
+}
+
+static void sc_for_each(const void *map, hash_map_visit_t visit, void *ctx)
+{
+    for_each_entry_sc(map, visit, ctx);
+}
+
+static void sc_destroy(void *map)
+{
+    delete_hash_map_sc(map);
+}
+
+static void *oa_init(void)
+{
+    return init_hash_map_oa();
+}
+
+static void oa_put(void *map, u32_t key, void *data)
+{
+    add_entry_oa(map, key, data);
+}
+
+static void *oa_get(const void *map, u32_t key)
+{
+    return get_entry_oa(map, key);
+}
+
+static bool oa_remove(void *map, u32_t key)
+{
+    return remove_entry_oa(map, key);
+}
+
+static void oa_for_each(const void *map, hash_map_visit_t visit, void *ctx)
+{
+    for_each_entry_oa(map, visit, ctx);
+}
+
+static void oa_destroy(void *map)
+{
+    delete_hash_map_oa(map);
+}
+
+static void *simd_init(void)
+{
+    return init_hash_map_simd();
+}
+
+static void simd_put(void *map, u32_t key, void *data)
+{
+    add_entry_simd(map, key, data);
+}
+
+static void *simd_get(const void *map, u32_t key)
+{
+    return get_entry_simd(map, key);
+}
+
+static bool simd_remove(void *map, u32_t key)
+{
+    return remove_entry_simd(map, key);
+}
+
+static void simd_for_each(const void *map, hash_map_visit_t visit, void *ctx)
+{
+    for_each_entry_simd(map, visit, ctx);
+}
+
+static void simd_destroy(void *map)
+{
+    delete_hash_map_simd(map);
+}
+
+static void *dense_init(void)
+{
+    return init_hash_map_dense();
+}
+
+static void dense_put(void *map, u32_t key, void *data)
+{
+    add_entry_dense(map, key, data);
+}
+
+static void *dense_get(const void *map, u32_t key)
+{
+    return get_entry_dense(map, key);
+}
+
+static bool dense_remove(void *map, u32_t key)
+{
+    return remove_entry_dense(map, key);
+}
+
+static void dense_for_each(const void *map, hash_map_visit_t visit, void *ctx)
+{
+    for_each_entry_dense(map, visit, ctx);
+}
+
+static void dense_destroy(void *map)
+{
+    delete_hash_map_dense(map);
+}
+
+static u32_t bench_key(size_t i)
+{
+    return (u32_t) i * BENCH_KEY_MUL;
+}
+
+static void bench_count_visit(u32_t key, void *data, void *ctx)
+{
+    (void) key;
+    *(size_t *) ctx += data != NULL;
+}
+
+static void **bench_payloads(size_t entries)
+{
+    void **payloads = malloc(entries * sizeof(void *));
+    check_mem_alloc((void *) payloads, "Bench payloads");
+    for (size_t i = 0; i < entries; i++)
+    {
+        payloads[i] = malloc(sizeof(size_t));
+        check_mem_alloc(payloads[i], "Bench payload");
+    }
+    return payloads;
+}
+
+static void bench_map(const bench_map_ops_t *ops, size_t entries)
+{
+    char   label[64];
+    void **payloads = bench_payloads(entries);
+    void  *map      = ops->init();
+
+    double start = bench_now();
+    for (size_t i = 0; i < entries; i++)
+    {
+        ops->put(map, bench_key(i), payloads[i]);
+    }
+    snprintf(label, sizeof(label), "%s put", ops->name);
+    bench_report(label, entries, bench_now() - start);
+
+    size_t found = 0;
+    start        = bench_now();
+    for (size_t i = 0; i < entries; i++)
+    {
+        found += ops->get(map, bench_key(i)) != NULL;
+    }
+    snprintf(label, sizeof(label), "%s get hit", ops->name);
+    bench_report(label, found, bench_now() - start);
+
+    size_t missed = 0;
+    start         = bench_now();
+    for (size_t i = 0; i < entries; i++)
+    {
+        missed += ops->get(map, bench_key(i) ^ BENCH_MISS_OFFSET) == NULL;
+    }
+    snprintf(label, sizeof(label), "%s get miss", ops->name);
+    bench_report(label, missed, bench_now() - start);
+
+    size_t visited = 0;
+    start          = bench_now();
+    ops->for_each(map, bench_count_visit, &visited);
+    snprintf(label, sizeof(label), "%s iterate", ops->name);
+    bench_report(label, visited, bench_now() - start);
+
+    size_t removed = 0;
+    start          = bench_now();
+    for (size_t i = 0; i < entries; i += 2)
+    {
+        removed += ops->remove(map, bench_key(i));
+    }
+    snprintf(label, sizeof(label), "%s remove", ops->name);
+    bench_report(label, removed, bench_now() - start);
+
+    ops->destroy(map);
+    free((void *) payloads);
+}
+
+int main(int argc, char **argv)
+{
+    size_t entries = bench_arg_count(argc, argv, 1, BENCH_DEFAULT_ENTRIES);
+    if (entries > BENCH_MISS_OFFSET)
+    {
+        entries = BENCH_MISS_OFFSET;
+    }
+
+    const bench_map_ops_t maps[] = {
+        {"hash_map_sc_t", sc_init, sc_put, sc_get, sc_remove, sc_for_each, sc_destroy},
+        {"hash_map_oa_t", oa_init, oa_put, oa_get, oa_remove, oa_for_each, oa_destroy},
+        {"hash_map_simd_t",
+         simd_init,
+         simd_put,
+         simd_get,
+         simd_remove,
+         simd_for_each,
+         simd_destroy},
+        {"hash_map_dense_t",
+         dense_init,
+         dense_put,
+         dense_get,
+         dense_remove,
+         dense_for_each,
+         dense_destroy},
+    };
+    for (size_t i = 0; i < sizeof(maps) / sizeof(maps[0]); i++)
+    {
+        bench_map(&maps[i], entries);
+    }
+    return EXIT_SUCCESS;
+}
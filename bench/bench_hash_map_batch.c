@@ -0,0 +1,126 @@
+/**
+ * @file bench_hash_map_batch.c
+ * @brief Single vs batched lookups on tables far larger than the last level cache
+ *
+ * The lookup keys are a random permutation of the stored keys, so almost every bucket, header
+ * and entry touched is a cache miss. Single lookups pay those misses one after the other,
+ * get_batch_* overlaps HASH_MAP_BATCH of them.
+ *
+ * Usage: bench_hash_map_batch [entries] [lookups]
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "bench_utils.h"
+#include "hash_map.h"
+
+#define BENCH_DEFAULT_ENTRIES 4000000U
+#define BENCH_DEFAULT_LOOKUPS 4000000U
+#define BENCH_KEY_MUL         2654435761U
+#define BENCH_LCG_MUL         6364136223846793005ULL
+#define BENCH_LCG_ADD         1442695040888963407ULL
+
+static u32_t *bench_lookup_keys(size_t entries, size_t lookups)
+{
+    u32_t             *keys  = malloc(lookups * sizeof(u32_t));
+    unsigned long long state = 1;
+    check_mem_alloc(keys, "Bench keys");
+    for (size_t i = 0; i < lookups; i++)
+    {
+        state   = state * BENCH_LCG_MUL + BENCH_LCG_ADD;
+        keys[i] = (u32_t) ((state >> 33U) % entries) * BENCH_KEY_MUL;
+    }
+    return keys;
+}
+
+static void **bench_payloads(size_t entries, u32_t *keys)
+{
+    void **data = malloc(entries * sizeof(void *));
+    check_mem_alloc((void *) data, "Bench payloads");
+    for (size_t i = 0; i < entries; i++)
+    {
+        keys[i] = (u32_t) i * BENCH_KEY_MUL;
+        data[i] = malloc(sizeof(size_t));
+        check_mem_alloc(data[i], "Bench payload");
+    }
+    return data;
+}
+
+static size_t bench_count(void *const *out, size_t n)
+{
+    size_t found = 0;
+    for (size_t i = 0; i < n; i++)
+    {
+        found += out[i] != NULL;
+    }
+    return found;
+}
+
+static void bench_sc(size_t entries, const u32_t *lookup, size_t lookups, void **out)
+{
+    hash_map_sc_t *map  = init_hash_map();
+    u32_t         *keys = malloc(entries * sizeof(u32_t));
+    check_mem_alloc(keys, "Bench keys");
+    void **data = bench_payloads(entries, keys);
+    add_batch_sc(map, keys, data, entries);
+    // Only settle a migration still running, on a settled map load_value_sc starts another one
+    if (map->old_buckets != NULL)
+    {
+        load_value_sc(map);
+    }
+
+    double start = bench_now();
+    for (size_t i = 0; i < lookups; i++)
+    {
+        out[i] = get_entry_sc(map, lookup[i]);
+    }
+    bench_report("hash_map_sc_t single get", bench_count(out, lookups), bench_now() - start);
+
+    start = bench_now();
+    get_batch_sc(map, lookup, lookups, out);
+    bench_report("hash_map_sc_t batch get", bench_count(out, lookups), bench_now() - start);
+
+    delete_hash_map_sc(map);
+    free((void *) data);
+    free(keys);
+}
+
+static void bench_oa(size_t entries, const u32_t *lookup, size_t lookups, void **out)
+{
+    hash_map_oa_t *map  = init_hash_map_oa();
+    u32_t         *keys = malloc(entries * sizeof(u32_t));
+    check_mem_alloc(keys, "Bench keys");
+    void **data = bench_payloads(entries, keys);
+    add_batch_oa(map, keys, data, entries);
+
+    double start = bench_now();
+    for (size_t i = 0; i < lookups; i++)
+    {
+        out[i] = get_entry_oa(map, lookup[i]);
+    }
+    bench_report("hash_map_oa_t single get", bench_count(out, lookups), bench_now() - start);
+
+    start = bench_now();
+    get_batch_oa(map, lookup, lookups, out);
+    bench_report("hash_map_oa_t batch get", bench_count(out, lookups), bench_now() - start);
+
+    delete_hash_map_oa(map);
+    free((void *) data);
+    free(keys);
+}
+
+int main(int argc, char **argv)
+{
+    size_t entries = bench_arg_count(argc, argv, 1, BENCH_DEFAULT_ENTRIES);
+    size_t lookups = bench_arg_count(argc, argv, 2, BENCH_DEFAULT_LOOKUPS);
+    u32_t *lookup  = bench_lookup_keys(entries, lookups);
+    void **out     = malloc(lookups * sizeof(void *));
+    check_mem_alloc((void *) out, "Bench results");
+
+    bench_sc(entries, lookup, lookups, out);
+    bench_oa(entries, lookup, lookups, out);
+
+    free((void *) out);
+    free(lookup);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,128 @@
+/**
+ * @file bench_hash_map_flat.c
+ * @brief Memory and lookups of flat chaining (hash_map_fc_t) vs list chaining (hash_map_sc_t)
+ *
+ * The default entry count leaves both tables at a load factor just under 0.75. Each map is
+ * built in its own child process and the growth of peak RSS over the empty process is reported,
+ * every entry shares one static payload so only the map itself is measured. The children exit
+ * without deleting the map, which would free that payload.
+ *
+ * Usage: bench_hash_map_flat [entries]
+ */
+
+#define _XOPEN_SOURCE 700
+
+#include "bench_utils.h"
+#include "hash_map.h"
+
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#define BENCH_DEFAULT_ENTRIES 3145728U // 0.75 * 2^22
+#define BENCH_KEY_MUL         2654435761U
+#define BENCH_MISS_OFFSET     0x80000000U
+#define BENCH_LCG_MUL         6364136223846793005ULL
+#define BENCH_LCG_ADD         1442695040888963407ULL
+#define BENCH_KIB_PER_MIB     1024.0
+
+static size_t s_payload;
+
+static double bench_peak_mib(void)
+{
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return (double) usage.ru_maxrss / BENCH_KIB_PER_MIB;
+}
+
+static u32_t bench_random_key(unsigned long long *state, size_t entries)
+{
+    *state = *state * BENCH_LCG_MUL + BENCH_LCG_ADD;
+    return (u32_t) ((*state >> 33U) % entries) * BENCH_KEY_MUL;
+}
+
+static void bench_lookups(const char *name, void *map, void *(*get)(const void *, u32_t),
+                          size_t entries)
+{
+    char               label[64];
+    unsigned long long state = 1;
+    size_t             found = 0;
+    double             start = bench_now();
+    for (size_t i = 0; i < entries; i++)
+    {
+        found += get(map, bench_random_key(&state, entries)) != NULL;
+    }
+    snprintf(label, sizeof(label), "%s random get hit", name);
+    bench_report(label, found, bench_now() - start);
+
+    size_t missed = 0;
+    start         = bench_now();
+    for (size_t i = 0; i < entries; i++)
+    {
+        missed += get(map, bench_random_key(&state, entries) ^ BENCH_MISS_OFFSET) == NULL;
+    }
+    snprintf(label, sizeof(label), "%s random get miss", name);
+    bench_report(label, missed, bench_now() - start);
+}
+
+static void *bench_get_sc(const void *map, u32_t key)
+{
+    return get_entry_sc(map, key);
+}
+
+static void *bench_get_fc(const void *map, u32_t key)
+{
+    return get_entry_fc(map, key);
+}
+
+static void bench_sc(size_t entries)
+{
+    double         before = bench_peak_mib();
+    hash_map_sc_t *map    = init_hash_map();
+    for (size_t i = 0; i < entries; i++)
+    {
+        add_entry_sc(map, (u32_t) i * BENCH_KEY_MUL, &s_payload);
+    }
+    if (map->old_buckets != NULL)
+    {
+        load_value_sc(map);
+    }
+    printf("hash_map_sc_t load %.3f, peak RSS +%.1f MiB\n", (double) map->load_factor,
+           bench_peak_mib() - before);
+    bench_lookups("hash_map_sc_t", map, bench_get_sc, entries);
+}
+
+static void bench_fc(size_t entries)
+{
+    double         before = bench_peak_mib();
+    hash_map_fc_t *map    = init_hash_map_fc();
+    for (size_t i = 0; i < entries; i++)
+    {
+        add_entry_fc(map, (u32_t) i * BENCH_KEY_MUL, &s_payload);
+    }
+    printf("hash_map_fc_t load %.3f, peak RSS +%.1f MiB (%zu overflow entries)\n",
+           (double) map->load_factor, bench_peak_mib() - before, map->overflow_used);
+    bench_lookups("hash_map_fc_t", map, bench_get_fc, entries);
+}
+
+static void bench_in_child(void (*run)(size_t), size_t entries)
+{
+    fflush(stdout);
+    pid_t pid = fork();
+    if (pid != 0)
+    {
+        waitpid(pid, NULL, 0);
+        return;
+    }
+    run(entries);
+    fflush(stdout);
+    _exit(EXIT_SUCCESS);
+}
+
+int main(int argc, char **argv)
+{
+    size_t entries = bench_arg_count(argc, argv, 1, BENCH_DEFAULT_ENTRIES);
+    bench_in_child(bench_sc, entries);
+    bench_in_child(bench_fc, entries);
+    return EXIT_SUCCESS;
+}
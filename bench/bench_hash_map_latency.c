@@ -0,0 +1,97 @@
+/**
+ * @file bench_hash_map_latency.c
+ * @brief Per insert latency of hash_map_sc_t growing incrementally vs all at once
+ *
+ * The stop-the-world run calls load_value_sc as soon as a migration starts, which is how the
+ * map behaved before growth became incremental. Latencies go in a log2 histogram so 10^8
+ * inserts need no per sample storage; percentiles are reported as the bucket upper bound.
+ *
+ * Usage: bench_hash_map_latency [entries]
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "bench_utils.h"
+#include "hash_map.h"
+
+#define BENCH_DEFAULT_ENTRIES 10000000U
+#define BENCH_KEY_MUL         2654435761U
+#define BENCH_HISTOGRAM_SIZE  48
+
+typedef struct bench_latency_t
+{
+    size_t histogram[BENCH_HISTOGRAM_SIZE]; // Bucket b counts latencies in [2^(b-1), 2^b) ns
+    double max_ns;
+} bench_latency_t;
+
+static void bench_record(bench_latency_t *latency, double seconds)
+{
+    double ns     = seconds * BENCH_NS_PER_SEC;
+    size_t bucket = 0;
+    while (bucket + 1 < BENCH_HISTOGRAM_SIZE && (double) ((size_t) 1 << bucket) <= ns)
+    {
+        bucket++;
+    }
+    latency->histogram[bucket]++;
+    if (ns > latency->max_ns)
+    {
+        latency->max_ns = ns;
+    }
+}
+
+static double bench_percentile(const bench_latency_t *latency, size_t total, double fraction)
+{
+    size_t target = (size_t) ((double) total * fraction);
+    size_t seen   = 0;
+    for (size_t bucket = 0; bucket < BENCH_HISTOGRAM_SIZE; bucket++)
+    {
+        seen += latency->histogram[bucket];
+        if (seen > target)
+        {
+            return (double) ((size_t) 1 << bucket);
+        }
+    }
+    return latency->max_ns;
+}
+
+static void bench_inserts(const char *label, size_t entries, bool stop_the_world)
+{
+    bench_latency_t latency = {{0}, 0.0};
+    hash_map_sc_t  *map     = init_hash_map();
+
+    // Untimed first put: its first pool slab is where malloc consolidates the chunks freed by
+    // the previous run, a one-off cost of the allocator rather than of the map
+    add_entry_sc(map, 0, malloc(sizeof(size_t)));
+    double start = bench_now();
+    for (size_t i = 1; i < entries; i++)
+    {
+        size_t *payload = malloc(sizeof(size_t));
+        check_mem_alloc(payload, "Bench payload");
+        double before = bench_now();
+        add_entry_sc(map, (u32_t) i * BENCH_KEY_MUL, payload);
+        if (stop_the_world && map->old_buckets != NULL)
+        {
+            load_value_sc(map);
+        }
+        bench_record(&latency, bench_now() - before);
+    }
+    bench_report(label, entries - 1, bench_now() - start);
+    printf("    p50 <= %.0f ns  p99 <= %.0f ns  p99.99 <= %.0f ns  max %.0f ns\n",
+           bench_percentile(&latency, entries - 1, 0.5),
+           bench_percentile(&latency, entries - 1, 0.99),
+           bench_percentile(&latency, entries - 1, 0.9999),
+           latency.max_ns);
+    delete_hash_map_sc(map);
+}
+
+int main(int argc, char **argv)
+{
+    size_t entries = bench_arg_count(argc, argv, 1, BENCH_DEFAULT_ENTRIES);
+    if (entries < 2)
+    {
+        entries = 2;
+    }
+    bench_inserts("hash_map_sc_t stop-the-world put", entries, TRUE);
+    bench_inserts("hash_map_sc_t incremental put", entries, FALSE);
+    return EXIT_SUCCESS;
+}
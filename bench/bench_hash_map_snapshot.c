@@ -0,0 +1,107 @@
+/**
+ * @file bench_hash_map_snapshot.c
+ * @brief Startup cost of rebuilding a byte-keyed map vs opening an mmap'd snapshot of it
+ *
+ * Usage: bench_hash_map_snapshot [entries] [snapshot path]
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "bench_utils.h"
+#include "hash_map.h"
+#include "hash_map_snapshot.h"
+
+#include <string.h>
+
+#define BENCH_DEFAULT_ENTRIES 1000000U
+#define BENCH_DEFAULT_PATH    "/tmp/bench_hash_map_snapshot.bin"
+#define BENCH_KEY_BUFFER      32
+#define BENCH_KEY_MUL         2654435761U
+
+static size_t bench_key(char *buffer, size_t i)
+{
+    return (size_t) snprintf(buffer, BENCH_KEY_BUFFER, "user:%zu", i * BENCH_KEY_MUL);
+}
+
+static hash_map_bytes_t *bench_rebuild(size_t entries)
+{
+    hash_map_bytes_t *map = init_hash_map_bytes(NULL, 0);
+    char              key[BENCH_KEY_BUFFER];
+    double            start = bench_now();
+    for (size_t i = 0; i < entries; i++)
+    {
+        size_t *value = malloc(sizeof(size_t));
+        check_mem_alloc(value, "Bench value");
+        *value = i;
+        add_entry_bytes(map, key, bench_key(key, i), value);
+    }
+    bench_report("rebuild hash_map_bytes_t (startup)", entries, bench_now() - start);
+    return map;
+}
+
+static void bench_write(size_t entries, const char *path)
+{
+    snapshot_builder_t *builder = snapshot_builder_init();
+    char                key[BENCH_KEY_BUFFER];
+    double              start = bench_now();
+    for (size_t i = 0; i < entries; i++)
+    {
+        snapshot_builder_add(builder, key, bench_key(key, i), &i, sizeof(i));
+    }
+    if (!snapshot_builder_write(builder, path))
+    {
+        exit(EXIT_FAILURE);
+    }
+    bench_report("snapshot build and write (offline)", entries, bench_now() - start);
+    snapshot_builder_destroy(builder);
+}
+
+int main(int argc, char **argv)
+{
+    size_t      entries = bench_arg_count(argc, argv, 1, BENCH_DEFAULT_ENTRIES);
+    const char *path    = argc > 2 ? argv[2] : BENCH_DEFAULT_PATH;
+    char        key[BENCH_KEY_BUFFER];
+
+    hash_map_bytes_t *map = bench_rebuild(entries);
+    bench_write(entries, path);
+
+    double               start    = bench_now();
+    hash_map_snapshot_t *snapshot = snapshot_open(path);
+    if (snapshot == NULL)
+    {
+        return EXIT_FAILURE;
+    }
+    double open_seconds = bench_now() - start;
+    printf("snapshot_open (startup) %.3f ms for %zu entries\n", open_seconds * 1000.0,
+           snapshot_size(snapshot));
+
+    size_t found = 0;
+    start        = bench_now();
+    for (size_t i = 0; i < entries; i++)
+    {
+        found += get_entry_bytes(map, key, bench_key(key, i)) != NULL;
+    }
+    bench_report("hash_map_bytes_t get", found, bench_now() - start);
+
+    // The first pass over the snapshot also pays the page faults of the cold mapping
+    found = 0;
+    start = bench_now();
+    for (size_t i = 0; i < entries; i++)
+    {
+        found += snapshot_get(snapshot, key, bench_key(key, i), NULL) != NULL;
+    }
+    bench_report("snapshot_get (first touch)", found, bench_now() - start);
+
+    found = 0;
+    start = bench_now();
+    for (size_t i = 0; i < entries; i++)
+    {
+        found += snapshot_get(snapshot, key, bench_key(key, i), NULL) != NULL;
+    }
+    bench_report("snapshot_get (warm)", found, bench_now() - start);
+
+    snapshot_close(snapshot);
+    delete_hash_map_bytes(map);
+    remove(path);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,96 @@
+/**
+ * @file bench_list_cursor.c
+ * @brief Sequential processing of a linked_list_t: indexed calls vs a cursor
+ *
+ * The indexed pass (get_element / remove_node per position) is O(n^2) and only runs up to
+ * BENCH_INDEXED_MAX elements; the cursor pass is linear and runs at every size.
+ *
+ * Usage: bench_list_cursor [max_elements]
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "bench_utils.h"
+#include "linked_list.h"
+
+#define BENCH_DEFAULT_MAX 1000000U
+#define BENCH_INDEXED_MAX 100000U
+#define BENCH_MIN_COUNT   10000U
+#define BENCH_STEP        10U
+
+static int s_payload;
+
+static linked_list_t *bench_build(size_t count)
+{
+    linked_list_t *list = init_linkedlist_pooled(NULL);
+    for (size_t i = 0; i < count; i++)
+    {
+        push_node(list, &s_payload);
+    }
+    return list;
+}
+
+static void bench_indexed(size_t count)
+{
+    linked_list_t *list  = bench_build(count);
+    size_t         seen  = 0;
+    double         start = bench_now();
+    for (size_t i = 0; i < count; i++)
+    {
+        seen += get_element(list, i) == &s_payload;
+    }
+    char label[64];
+    snprintf(label, sizeof(label), "get_element scan n=%zu", count);
+    bench_report(label, seen, bench_now() - start);
+
+    while (get_linked_list_size(list) > 0)
+    {
+        pop_tail(list);
+    }
+    delete_linkedlist(list);
+}
+
+static void bench_cursor(size_t count)
+{
+    linked_list_t *list  = bench_build(count);
+    size_t         seen  = 0;
+    double         start = bench_now();
+    for (list_cursor_t c = list_cursor_front(list); list_cursor_valid(&c); list_cursor_next(&c))
+    {
+        seen += list_cursor_get(&c) == &s_payload;
+    }
+    char label[64];
+    snprintf(label, sizeof(label), "cursor scan n=%zu", count);
+    bench_report(label, seen, bench_now() - start);
+
+    // Filter out every other node while walking
+    start           = bench_now();
+    list_cursor_t c = list_cursor_front(list);
+    while (list_cursor_valid(&c))
+    {
+        list_cursor_remove(&c);
+        list_cursor_next(&c);
+    }
+    snprintf(label, sizeof(label), "cursor erase every other n=%zu", count);
+    bench_report(label, count / 2, bench_now() - start);
+
+    while (get_linked_list_size(list) > 0)
+    {
+        pop_tail(list);
+    }
+    delete_linkedlist(list);
+}
+
+int main(int argc, char **argv)
+{
+    size_t max_count = bench_arg_count(argc, argv, 1, BENCH_DEFAULT_MAX);
+    for (size_t count = BENCH_MIN_COUNT; count <= max_count; count *= BENCH_STEP)
+    {
+        if (count <= BENCH_INDEXED_MAX)
+        {
+            bench_indexed(count);
+        }
+        bench_cursor(count);
+    }
+    return EXIT_SUCCESS;
+}
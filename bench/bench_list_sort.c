@@ -0,0 +1,52 @@
+/**
+ * @file bench_list_sort.c
+ * @brief list_sort on a linked_list_t of random ints
+ *
+ * The sort only relinks nodes: no allocation happens between build and teardown.
+ *
+ * Usage: bench_list_sort [elements]
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "bench_utils.h"
+#include "linked_list.h"
+
+#define BENCH_DEFAULT_COUNT 10000000U
+#define BENCH_LCG_MUL       6364136223846793005ULL
+#define BENCH_LCG_ADD       1442695040888963407ULL
+
+static int bench_cmp(const void *a, const void *b)
+{
+    int left  = *(const int *) a;
+    int right = *(const int *) b;
+    return (left > right) - (left < right);
+}
+
+int main(int argc, char **argv)
+{
+    size_t count  = bench_arg_count(argc, argv, 1, BENCH_DEFAULT_COUNT);
+    int   *values = malloc(count * sizeof(int));
+    check_mem_alloc(values, "bench values");
+
+    linked_list_t     *list  = init_linkedlist();
+    unsigned long long state = 1;
+    for (size_t i = 0; i < count; i++)
+    {
+        state     = state * BENCH_LCG_MUL + BENCH_LCG_ADD;
+        values[i] = (int) (state >> 33U);
+        push_node(list, &values[i]);
+    }
+
+    double start = bench_now();
+    list_sort(list, bench_cmp);
+    bench_report("list_sort", count, bench_now() - start);
+
+    while (get_linked_list_size(list) > 0)
+    {
+        pop_tail(list);
+    }
+    delete_linkedlist(list);
+    free(values);
+    return EXIT_SUCCESS;
+}
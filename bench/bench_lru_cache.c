@@ -0,0 +1,224 @@
+/**
+ * @file bench_lru_cache.c
+ * @brief LRU hit path and cache-aside throughput under a Zipfian key distribution
+ *
+ * Key ranks follow Zipf's law with exponent 1 (P(rank r) ~ 1 / r), drawn from a precomputed
+ * harmonic CDF, and are scrambled into u32 keys so hot keys are not neighbours. The whole key
+ * stream is drawn before timing. Reported:
+ *   - cache-aside on lru_cache_t: get, put a fresh value on a miss, with the hit ratio
+ *   - the hit path alone: gets of the most popular ranks, kept to the ones found resident
+ *   - the same cache-aside loop on lru_sharded_t with 1 and with [threads] threads
+ *
+ * Usage: bench_lru_cache [keys] [capacity] [operations] [threads]
+ * with keys >= 1, capacity >= 2 and threads >= 1.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "bench_utils.h"
+#include "lru_cache.h"
+
+#include <pthread.h>
+
+#define BENCH_DEFAULT_KEYS     1000000U
+#define BENCH_DEFAULT_CAPACITY 100000U
+#define BENCH_DEFAULT_OPS      4000000U
+#define BENCH_DEFAULT_THREADS  4U
+#define BENCH_KEY_MUL          2654435761U
+#define BENCH_LCG_MUL          6364136223846793005ULL
+#define BENCH_LCG_ADD          1442695040888963407ULL
+#define BENCH_LCG_UNIT         0x1p-53 // 53 random bits to a double in [0, 1)
+
+typedef struct bench_worker_t
+{
+    lru_sharded_t *cache;
+    const u32_t   *keys;
+    size_t         count;
+    size_t         hits;
+} bench_worker_t;
+
+static double bench_uniform(unsigned long long *state)
+{
+    *state = *state * BENCH_LCG_MUL + BENCH_LCG_ADD;
+    return (double) (*state >> 11U) * BENCH_LCG_UNIT;
+}
+
+/*
+ * @brief cdf[r] = H(r + 1) / H(keys), the probability of a rank <= r
+ */
+static double *bench_zipf_cdf(size_t keys)
+{
+    double *cdf = malloc(keys * sizeof(double));
+    check_mem_alloc(cdf, "Bench cdf");
+    double sum = 0.0;
+    for (size_t r = 0; r < keys; r++)
+    {
+        sum += 1.0 / (double) (r + 1);
+        cdf[r] = sum;
+    }
+    for (size_t r = 0; r < keys; r++)
+    {
+        cdf[r] /= sum;
+    }
+    return cdf;
+}
+
+/*
+ * @brief count keys of Zipfian rank below max_rank (1 <= max_rank <= the CDF length), by binary
+ * search of the CDF
+ */
+static u32_t *bench_zipf_keys(const double *cdf, size_t max_rank, size_t count,
+                              unsigned long long *state)
+{
+    u32_t *keys  = malloc(count * sizeof(u32_t));
+    double scale = cdf[max_rank - 1];
+    check_mem_alloc(keys, "Bench keys");
+    for (size_t i = 0; i < count; i++)
+    {
+        double u  = bench_uniform(state) * scale;
+        size_t lo = 0;
+        size_t hi = max_rank - 1;
+        while (lo < hi)
+        {
+            size_t mid = lo + (hi - lo) / 2;
+            if (cdf[mid] <= u)
+            {
+                lo = mid + 1;
+            }
+            else
+            {
+                hi = mid;
+            }
+        }
+        keys[i] = (u32_t) lo * BENCH_KEY_MUL;
+    }
+    return keys;
+}
+
+static void *bench_value(u32_t key)
+{
+    u32_t *value = malloc(sizeof(u32_t));
+    check_mem_alloc(value, "Bench value");
+    *value = key;
+    return value;
+}
+
+static void bench_lru(const u32_t *keys, size_t ops, u32_t *hot, size_t capacity)
+{
+    lru_cache_t *cache = lru_init(capacity, 0);
+    double       start = bench_now();
+    for (size_t i = 0; i < ops; i++)
+    {
+        if (lru_get(cache, keys[i]) == NULL)
+        {
+            lru_put(cache, keys[i], bench_value(keys[i]), sizeof(u32_t));
+        }
+    }
+    bench_report("lru_cache_t cache-aside", ops, bench_now() - start);
+    printf("hit ratio %.3f, %zu evictions\n", (double) cache->hits / (double) ops,
+           cache->evictions);
+
+    // Keep the hot keys found resident, gets never evict so every timed get below hits
+    size_t hits = 0;
+    for (size_t i = 0; i < ops; i++)
+    {
+        if (lru_get(cache, hot[i]) != NULL)
+        {
+            hot[hits++] = hot[i];
+        }
+    }
+    start = bench_now();
+    for (size_t i = 0; i < hits; i++)
+    {
+        if (lru_get(cache, hot[i]) == NULL)
+        {
+            exit(EXIT_FAILURE);
+        }
+    }
+    bench_report("lru_get hit path", hits, bench_now() - start);
+    lru_destroy(cache);
+}
+
+static void *bench_sharded_worker(void *arg)
+{
+    bench_worker_t *worker = arg;
+    for (size_t i = 0; i < worker->count; i++)
+    {
+        u32_t key = worker->keys[i];
+        if (lru_sharded_get(worker->cache, key, NULL, NULL))
+        {
+            worker->hits++;
+        }
+        else
+        {
+            lru_sharded_put(worker->cache, key, bench_value(key), sizeof(u32_t));
+        }
+    }
+    return NULL;
+}
+
+static void bench_sharded(const u32_t *keys, size_t ops, size_t capacity, size_t threads)
+{
+    lru_sharded_t  *cache   = lru_sharded_init(0, capacity, 0);
+    pthread_t      *ids     = malloc(threads * sizeof(pthread_t));
+    bench_worker_t *workers = malloc(threads * sizeof(bench_worker_t));
+    check_mem_alloc(ids, "Bench threads");
+    check_mem_alloc(workers, "Bench workers");
+
+    size_t share = ops / threads;
+    double start = bench_now();
+    for (size_t t = 0; t < threads; t++)
+    {
+        workers[t] = (bench_worker_t) {cache, keys + t * share, share, 0};
+        if (pthread_create(&ids[t], NULL, bench_sharded_worker, &workers[t]) != 0)
+        {
+            exit(EXIT_FAILURE);
+        }
+    }
+    size_t hits = 0;
+    for (size_t t = 0; t < threads; t++)
+    {
+        pthread_join(ids[t], NULL);
+        hits += workers[t].hits;
+    }
+    double seconds = bench_now() - start;
+
+    char label[64];
+    snprintf(label, sizeof(label), "lru_sharded_t cache-aside %zu threads", threads);
+    bench_report(label, share * threads, seconds);
+    printf("hit ratio %.3f over %zu shards\n", (double) hits / (double) (share * threads),
+           lru_sharded_shard_count(cache));
+    lru_sharded_destroy(cache);
+    free(ids);
+    free(workers);
+}
+
+int main(int argc, char **argv)
+{
+    size_t keys     = bench_arg_count(argc, argv, 1, BENCH_DEFAULT_KEYS);
+    size_t capacity = bench_arg_count(argc, argv, 2, BENCH_DEFAULT_CAPACITY);
+    size_t ops      = bench_arg_count(argc, argv, 3, BENCH_DEFAULT_OPS);
+    size_t threads  = bench_arg_count(argc, argv, 4, BENCH_DEFAULT_THREADS);
+
+    // The top half of the capacity by popularity stays resident under the stream
+    size_t hot_ranks = capacity / 2 < keys ? capacity / 2 : keys;
+    if (keys == 0 || hot_ranks == 0 || threads == 0)
+    {
+        fprintf(stderr, "Usage: %s [keys >= 1] [capacity >= 2] [operations] [threads >= 1]\n",
+                argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    unsigned long long state  = 1;
+    double            *cdf    = bench_zipf_cdf(keys);
+    u32_t             *stream = bench_zipf_keys(cdf, keys, ops, &state);
+    u32_t             *hot    = bench_zipf_keys(cdf, hot_ranks, ops, &state);
+    free(cdf);
+
+    bench_lru(stream, ops, hot, capacity);
+    bench_sharded(stream, ops, capacity, 1);
+    bench_sharded(stream, ops, capacity, threads);
+    free(stream);
+    free(hot);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,156 @@
+/**
+ * @file bench_perfect_hash.c
+ * @brief Static perfect_map_t vs the dynamic maps on the same read-only key set
+ *
+ * Reports the serial and threaded build of the minimal perfect hash and its bits per key, then
+ * random hit and miss lookups on perfect_map_t, hash_map_sc_t, hash_map_oa_t and
+ * hash_map_simd_t, with the table bytes per entry of the flat ones. Every entry shares one static payload and the maps are never deleted, which
+ * would free it.
+ *
+ * Usage: bench_perfect_hash [entries] [threads]
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "bench_utils.h"
+#include "hash_map.h"
+#include "perfect_hash.h"
+
+#define BENCH_DEFAULT_ENTRIES 10000000U // 100000000 for the 10^8 build
+#define BENCH_KEY_MUL         2654435761U
+#define BENCH_MISS_OFFSET     0x80000000U
+#define BENCH_LCG_MUL         6364136223846793005ULL
+#define BENCH_LCG_ADD         1442695040888963407ULL
+
+static size_t s_payload;
+
+static u32_t bench_random_key(unsigned long long *state, size_t entries)
+{
+    *state = *state * BENCH_LCG_MUL + BENCH_LCG_ADD;
+    return (u32_t) ((*state >> 33U) % entries) * BENCH_KEY_MUL;
+}
+
+static void bench_lookups(const char *name, const void *map, void *(*get)(const void *, u32_t),
+                          size_t entries)
+{
+    char               label[64];
+    unsigned long long state = 1;
+    size_t             found = 0;
+    double             start = bench_now();
+    for (size_t i = 0; i < entries; i++)
+    {
+        found += get(map, bench_random_key(&state, entries)) != NULL;
+    }
+    snprintf(label, sizeof(label), "%s random get hit", name);
+    bench_report(label, found, bench_now() - start);
+
+    size_t missed = 0;
+    start         = bench_now();
+    for (size_t i = 0; i < entries; i++)
+    {
+        missed += get(map, bench_random_key(&state, entries) ^ BENCH_MISS_OFFSET) == NULL;
+    }
+    snprintf(label, sizeof(label), "%s random get miss", name);
+    bench_report(label, missed, bench_now() - start);
+}
+
+static void *bench_get_perfect(const void *map, u32_t key)
+{
+    return perfect_map_get(map, key);
+}
+
+static void *bench_get_sc(const void *map, u32_t key)
+{
+    return get_entry_sc(map, key);
+}
+
+static void *bench_get_oa(const void *map, u32_t key)
+{
+    return get_entry_oa(map, key);
+}
+
+static void *bench_get_simd(const void *map, u32_t key)
+{
+    return get_entry_simd(map, key);
+}
+
+static void bench_perfect(const u32_t *keys, size_t entries, size_t threads)
+{
+    double          start  = bench_now();
+    perfect_hash_t *serial = mph_build(keys, entries, 1);
+    bench_report("mph_build 1 thread", entries, bench_now() - start);
+    mph_destroy(serial);
+
+    void **values = malloc(entries * sizeof(void *));
+    check_mem_alloc((void *) values, "Bench values");
+    for (size_t i = 0; i < entries; i++)
+    {
+        values[i] = &s_payload;
+    }
+    start              = bench_now();
+    perfect_map_t *map = perfect_map_build(keys, values, entries, threads);
+    bench_report("perfect_map_build threaded", entries, bench_now() - start);
+    free((void *) values);
+    if (map == NULL)
+    {
+        exit(EXIT_FAILURE);
+    }
+    double bits = mph_bits_per_key(map->hash);
+    printf("mph %.2f bits/key over %zu levels, table %.2f bytes/entry\n", bits,
+           map->hash->level_count, (double) sizeof(perfect_entry_t) + bits / 8.0);
+    bench_lookups("perfect_map_t", map, bench_get_perfect, entries);
+}
+
+static void bench_dynamic(const u32_t *keys, size_t entries)
+{
+    hash_map_sc_t *sc    = init_hash_map();
+    double         start = bench_now();
+    for (size_t i = 0; i < entries; i++)
+    {
+        add_entry_sc(sc, keys[i], &s_payload);
+    }
+    if (sc->old_buckets != NULL)
+    {
+        load_value_sc(sc);
+    }
+    bench_report("hash_map_sc_t build", entries, bench_now() - start);
+    bench_lookups("hash_map_sc_t", sc, bench_get_sc, entries);
+
+    hash_map_oa_t *oa = init_hash_map_oa();
+    start             = bench_now();
+    for (size_t i = 0; i < entries; i++)
+    {
+        add_entry_oa(oa, keys[i], &s_payload);
+    }
+    bench_report("hash_map_oa_t build", entries, bench_now() - start);
+    printf("hash_map_oa_t table %.2f bytes/entry\n",
+           (double) (oa->capacity * sizeof(oa_slot_t)) / (double) entries);
+    bench_lookups("hash_map_oa_t", oa, bench_get_oa, entries);
+
+    hash_map_simd_t *simd = init_hash_map_simd();
+    start                 = bench_now();
+    for (size_t i = 0; i < entries; i++)
+    {
+        add_entry_simd(simd, keys[i], &s_payload);
+    }
+    bench_report("hash_map_simd_t build", entries, bench_now() - start);
+    printf("hash_map_simd_t table %.2f bytes/entry\n",
+           (double) (simd->capacity * (sizeof(simd_slot_t) + ONE)) / (double) entries);
+    bench_lookups("hash_map_simd_t", simd, bench_get_simd, entries);
+}
+
+int main(int argc, char **argv)
+{
+    size_t entries = bench_arg_count(argc, argv, 1, BENCH_DEFAULT_ENTRIES);
+    size_t threads = bench_arg_count(argc, argv, 2, 0);
+    u32_t *keys    = malloc(entries * sizeof(u32_t));
+    check_mem_alloc(keys, "Bench keys");
+    for (size_t i = 0; i < entries; i++)
+    {
+        keys[i] = (u32_t) i * BENCH_KEY_MUL;
+    }
+    bench_perfect(keys, entries, threads);
+    bench_dynamic(keys, entries);
+    free(keys);
+    return EXIT_SUCCESS;
+}
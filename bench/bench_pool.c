@@ -0,0 +1,66 @@
+/**
+ * @file bench_pool.c
+ * @brief linked_list_t node churn and teardown with malloc'd nodes vs a slab pool
+ *
+ * Usage: bench_pool [operations]
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "bench_utils.h"
+#include "linked_list.h"
+#include "pool.h"
+
+#define BENCH_DEFAULT_OPS 10000000U
+#define BENCH_QUEUE_DEPTH 1000U
+
+static linked_list_t *bench_new_list(bool pooled)
+{
+    return pooled ? init_linkedlist_pooled(NULL) : init_linkedlist();
+}
+
+static void bench_churn(bool pooled, size_t ops)
+{
+    linked_list_t *list = bench_new_list(pooled);
+    for (size_t i = 0; i < BENCH_QUEUE_DEPTH; i++)
+    {
+        push_node(list, NULL);
+    }
+    double start = bench_now();
+    for (size_t i = 0; i < ops; i++)
+    {
+        push_node(list, NULL);
+        pop_head(list);
+    }
+    bench_report(pooled ? "push/pop churn, pooled nodes" : "push/pop churn, malloc nodes",
+                 ops,
+                 bench_now() - start);
+    delete_linkedlist(list);
+}
+
+static void bench_build_teardown(bool pooled, size_t count)
+{
+    linked_list_t *list  = bench_new_list(pooled);
+    double         start = bench_now();
+    for (size_t i = 0; i < count; i++)
+    {
+        push_node(list, NULL);
+    }
+    bench_report(pooled ? "build, pooled nodes" : "build, malloc nodes", count, bench_now() - start);
+
+    start = bench_now();
+    delete_linkedlist(list);
+    bench_report(pooled ? "teardown, pooled nodes" : "teardown, malloc nodes",
+                 count,
+                 bench_now() - start);
+}
+
+int main(int argc, char **argv)
+{
+    size_t ops = bench_arg_count(argc, argv, 1, BENCH_DEFAULT_OPS);
+    bench_churn(false, ops);
+    bench_churn(true, ops);
+    bench_build_teardown(false, ops);
+    bench_build_teardown(true, ops);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,95 @@
+/**
+ * @file bench_segmented_array.c
+ * @brief Append latency and peak RSS of segmented_array_t vs dynamic_array_t
+ *
+ * Each container runs in its own child process so ru_maxrss is not shared. Latency is
+ * measured per batch of BENCH_BATCH pushes: the worst batch shows the realloc copy stalls
+ * of dynarray_push that segarray_push never has.
+ *
+ * Usage: bench_segmented_array [elements]
+ */
+
+#define _XOPEN_SOURCE 700
+
+#include "bench_utils.h"
+#include "dynamic_array.h"
+#include "segmented_array.h"
+
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#define BENCH_DEFAULT_COUNT 100000000U
+#define BENCH_BATCH         1024U
+#define BENCH_KIB_PER_MIB   1024.0
+
+static int s_payload;
+
+typedef bool (*bench_push_fn)(void *container, void *element);
+
+static bool bench_dynarray_push(void *container, void *element)
+{
+    return dynarray_push(container, element);
+}
+
+static bool bench_segarray_push(void *container, void *element)
+{
+    return segarray_push(container, element);
+}
+
+static void bench_appends(const char *label, void *container, bench_push_fn push, size_t count)
+{
+    double worst = 0.0;
+    double start = bench_now();
+    for (size_t done = 0; done < count; done += BENCH_BATCH)
+    {
+        double batch_start = bench_now();
+        for (size_t i = done; i < count && i < done + BENCH_BATCH; i++)
+        {
+            push(container, &s_payload);
+        }
+        double batch = bench_now() - batch_start;
+        worst        = batch > worst ? batch : worst;
+    }
+    bench_report(label, count, bench_now() - start);
+
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    printf("  worst batch of %u pushes %.3f ms, peak RSS %.1f MiB\n",
+           BENCH_BATCH,
+           worst * 1000.0,
+           (double) usage.ru_maxrss / BENCH_KIB_PER_MIB);
+}
+
+static void bench_in_child(bool segmented, size_t count)
+{
+    fflush(stdout);
+    pid_t pid = fork();
+    if (pid != 0)
+    {
+        waitpid(pid, NULL, 0);
+        return;
+    }
+    if (segmented)
+    {
+        segmented_array_t *arr = segarray_init();
+        bench_appends("segarray_push", arr, bench_segarray_push, count);
+        segarray_destroy(arr);
+    }
+    else
+    {
+        dynamic_array_t *arr = dynarray_init();
+        bench_appends("dynarray_push", arr, bench_dynarray_push, count);
+        dynarray_destroy(arr);
+    }
+    fflush(stdout);
+    _exit(EXIT_SUCCESS);
+}
+
+int main(int argc, char **argv)
+{
+    size_t count = bench_arg_count(argc, argv, 1, BENCH_DEFAULT_COUNT);
+    bench_in_child(false, count);
+    bench_in_child(true, count);
+    return EXIT_SUCCESS;
+}
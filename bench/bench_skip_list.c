@@ -0,0 +1,107 @@
+/**
+ * @file bench_skip_list.c
+ * @brief Random positional inserts and reads: linked_list_t vs dynamic_array_t vs skip_list_t
+ *
+ * Usage: bench_skip_list [operations]
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "bench_utils.h"
+#include "dynamic_array.h"
+#include "linked_list.h"
+#include "skip_list.h"
+
+#define BENCH_DEFAULT_OPS 20000U
+#define BENCH_LCG_MUL     6364136223846793005ULL
+#define BENCH_LCG_ADD     1442695040888963407ULL
+
+static int s_payload;
+
+static size_t bench_next_index(unsigned long long *state, size_t bound)
+{
+    *state = *state * BENCH_LCG_MUL + BENCH_LCG_ADD;
+    return (size_t) (*state >> 33U) % bound;
+}
+
+static void bench_linked_list(size_t ops)
+{
+    linked_list_t     *list  = init_linkedlist_pooled(NULL);
+    unsigned long long state = 1;
+    double             start = bench_now();
+    for (size_t i = 0; i < ops; i++)
+    {
+        insert_node(list, bench_next_index(&state, i + 1), &s_payload);
+    }
+    bench_report("linked_list_t random insert", ops, bench_now() - start);
+
+    size_t seen = 0;
+    start       = bench_now();
+    for (size_t i = 0; i < ops; i++)
+    {
+        seen += get_element(list, bench_next_index(&state, ops)) == &s_payload;
+    }
+    bench_report("linked_list_t random get", seen, bench_now() - start);
+
+    while (get_linked_list_size(list) > 0)
+    {
+        pop_tail(list);
+    }
+    delete_linkedlist(list);
+}
+
+static void bench_dynamic_array(size_t ops)
+{
+    dynamic_array_t   *arr   = dynarray_init();
+    unsigned long long state = 1;
+    double             start = bench_now();
+    for (size_t i = 0; i < ops; i++)
+    {
+        dynarray_set(arr, bench_next_index(&state, i + 1), &s_payload);
+    }
+    bench_report("dynamic_array_t random insert", ops, bench_now() - start);
+
+    size_t seen = 0;
+    start       = bench_now();
+    for (size_t i = 0; i < ops; i++)
+    {
+        seen += dynarray_get(arr, bench_next_index(&state, ops)) == &s_payload;
+    }
+    bench_report("dynamic_array_t random get", seen, bench_now() - start);
+    dynarray_destroy(arr);
+}
+
+static void bench_skip_list(size_t ops)
+{
+    skip_list_t       *list  = skiplist_init();
+    unsigned long long state = 1;
+    double             start = bench_now();
+    for (size_t i = 0; i < ops; i++)
+    {
+        skiplist_insert_node(list, bench_next_index(&state, i + 1), &s_payload);
+    }
+    bench_report("skip_list_t random insert", ops, bench_now() - start);
+
+    size_t seen = 0;
+    start       = bench_now();
+    for (size_t i = 0; i < ops; i++)
+    {
+        seen += skiplist_get_element(list, bench_next_index(&state, ops)) == &s_payload;
+    }
+    bench_report("skip_list_t random get", seen, bench_now() - start);
+
+    while (skiplist_size(list) > 0)
+    {
+        skiplist_pop_tail(list);
+    }
+    skiplist_delete(list);
+}
+
+int main(int argc, char **argv)
+{
+    size_t ops = bench_arg_count(argc, argv, 1, BENCH_DEFAULT_OPS);
+    bench_linked_list(ops);
+    bench_dynamic_array(ops);
+    bench_skip_list(ops);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,78 @@
+/**
+ * @file bench_typed_array.c
+ * @brief Sequential scan of boxed ints in dynamic_array_t vs inline ints in a typed array
+ *
+ * Usage: bench_typed_array [elements]
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "bench_utils.h"
+#include "dynamic_array.h"
+#include "typed_array.h"
+
+#define BENCH_DEFAULT_COUNT 10000000U
+#define BENCH_ROUNDS        10U
+
+DYNARRAY_DEFINE(bench_int_array, int)
+
+static void bench_boxed(size_t count)
+{
+    dynamic_array_t *arr = dynarray_init_with_capacity(count);
+    for (size_t i = 0; i < count; i++)
+    {
+        int *value = malloc(sizeof(int));
+        check_mem_alloc(value, "bench value");
+        *value = (int) (i & 0xFF);
+        dynarray_push(arr, value);
+    }
+
+    long long sum   = 0;
+    double    start = bench_now();
+    for (size_t round = 0; round < BENCH_ROUNDS; round++)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            sum += *(int *) dynarray_get(arr, i);
+        }
+    }
+    bench_report("scan dynamic_array_t (void *)", count * BENCH_ROUNDS, bench_now() - start);
+    printf("  checksum %lld\n", sum);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        free(arr->data[i]);
+    }
+    dynarray_destroy(arr);
+}
+
+static void bench_inline(size_t count)
+{
+    bench_int_array_t *arr = bench_int_array_init();
+    for (size_t i = 0; i < count; i++)
+    {
+        bench_int_array_push(arr, (int) (i & 0xFF));
+    }
+
+    long long sum   = 0;
+    double    start = bench_now();
+    for (size_t round = 0; round < BENCH_ROUNDS; round++)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            sum += *bench_int_array_get(arr, i);
+        }
+    }
+    bench_report("scan DYNARRAY_DEFINE(int)", count * BENCH_ROUNDS, bench_now() - start);
+    printf("  checksum %lld\n", sum);
+
+    bench_int_array_destroy(arr);
+}
+
+int main(int argc, char **argv)
+{
+    size_t count = bench_arg_count(argc, argv, 1, BENCH_DEFAULT_COUNT);
+    bench_boxed(count);
+    bench_inline(count);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,98 @@
+/**
+ * @file bench_unrolled_list.c
+ * @brief Traversal and indexed access: linked_list_t vs unrolled_list_t
+ *
+ * Usage: bench_unrolled_list [elements]
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "bench_utils.h"
+#include "linked_list.h"
+#include "unrolled_list.h"
+
+#define BENCH_DEFAULT_COUNT 1000000U
+#define BENCH_LOOKUPS       1000U
+#define BENCH_LCG_MUL       6364136223846793005ULL
+#define BENCH_LCG_ADD       1442695040888963407ULL
+
+static int s_payload;
+
+static size_t bench_next_index(unsigned long long *state, size_t bound)
+{
+    *state = *state * BENCH_LCG_MUL + BENCH_LCG_ADD;
+    return (size_t) (*state >> 33U) % bound;
+}
+
+static void bench_linked_list(size_t count)
+{
+    linked_list_t *list = init_linkedlist();
+    for (size_t i = 0; i < count; i++)
+    {
+        push_node(list, &s_payload);
+    }
+
+    size_t seen  = 0;
+    double start = bench_now();
+    for (node_t *node = list->head; node != NULL; node = node->next)
+    {
+        seen += node->value == &s_payload;
+    }
+    bench_report("traverse linked_list_t", seen, bench_now() - start);
+
+    unsigned long long state = 1;
+    start                    = bench_now();
+    for (size_t i = 0; i < BENCH_LOOKUPS; i++)
+    {
+        seen += get_element(list, bench_next_index(&state, count)) == &s_payload;
+    }
+    bench_report("get_element linked_list_t", BENCH_LOOKUPS, bench_now() - start);
+
+    while (get_linked_list_size(list) > 0)
+    {
+        pop_tail(list);
+    }
+    delete_linkedlist(list);
+}
+
+static void bench_unrolled_list(size_t count)
+{
+    unrolled_list_t *list = ulist_init();
+    for (size_t i = 0; i < count; i++)
+    {
+        ulist_push_node(list, &s_payload);
+    }
+
+    size_t seen  = 0;
+    double start = bench_now();
+    for (unode_t *node = list->head; node != NULL; node = node->next)
+    {
+        for (size_t i = 0; i < node->count; i++)
+        {
+            seen += node->values[i] == &s_payload;
+        }
+    }
+    bench_report("traverse unrolled_list_t", seen, bench_now() - start);
+
+    unsigned long long state = 1;
+    start                    = bench_now();
+    for (size_t i = 0; i < BENCH_LOOKUPS; i++)
+    {
+        seen += ulist_get_element(list, bench_next_index(&state, count)) == &s_payload;
+    }
+    bench_report("get_element unrolled_list_t", BENCH_LOOKUPS, bench_now() - start);
+
+    while (ulist_size(list) > 0)
+    {
+        ulist_pop_tail(list);
+    }
+    ulist_delete(list);
+}
+
+int main(int argc, char **argv)
+{
+    size_t count = bench_arg_count(argc, argv, 1, BENCH_DEFAULT_COUNT);
+    bench_linked_list(count);
+    bench_unrolled_list(count);
+    return EXIT_SUCCESS;
+}
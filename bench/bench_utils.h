@@ -0,0 +1,51 @@
+/**
+ * @file bench_utils.h
+ * @brief Tiny timing helpers shared by the benchmark programs
+ *
+ * Every benchmark is a standalone program built by `make bench` into build/bench/.
+ */
+
+#ifndef C_WORL_BENCH_UTILS_H
+#define C_WORL_BENCH_UTILS_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define BENCH_NS_PER_SEC 1000000000.0
+
+/**
+ * @brief Monotonic wall clock in seconds
+ */
+static inline double bench_now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double) ts.tv_sec + (double) ts.tv_nsec / BENCH_NS_PER_SEC;
+}
+
+/**
+ * @brief Parse argv[index] as an element count, falling back to default_count
+ */
+static inline size_t bench_arg_count(int argc, char **argv, int index, size_t default_count)
+{
+    if (argc <= index)
+    {
+        return default_count;
+    }
+    return (size_t) strtoull(argv[index], NULL, 10);
+}
+
+/**
+ * @brief Print one result line as nanoseconds per operation
+ */
+static inline void bench_report(const char *label, size_t ops, double seconds)
+{
+    printf("%-40s %12zu ops %10.3f s %10.2f ns/op\n",
+           label,
+           ops,
+           seconds,
+           seconds * BENCH_NS_PER_SEC / (double) ops);
+}
+
+#endif // C_WORL_BENCH_UTILS_H
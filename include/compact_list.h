@@ -0,0 +1,71 @@
+/**
+ * @file compact_list.h
+ * @brief Doubly linked list stored as parallel arrays linked by 32-bit indexes
+ *
+ * Nodes are slots of one growable arena kept as struct-of-arrays (values, prev, next), so a
+ * link costs 2 x 4 bytes instead of 2 x 8, nodes never need their own allocation, and a
+ * traversal stays inside three contiguous buffers. Removed slots go to a free-index list and
+ * are reused first. Copying a whole list is one memcpy per array (clist_clone).
+ * Operations and value ownership mirror linked_list.h; out of range indexes call throw_error.
+ * Time: O(1) amortized push and pop, O(min(i, n - i)) insert, remove and get
+ * Space: O(capacity), at most CLIST_MAX_CAPACITY nodes
+ */
+
+#ifndef C_WORL_COMPACT_LIST_H
+#define C_WORL_COMPACT_LIST_H
+
+#include "utils.h"
+
+#include <stddef.h>
+
+#define CLIST_NIL              UINT32_MAX
+#define CLIST_MAX_CAPACITY     (UINT32_MAX - 1U)
+#define CLIST_INITIAL_CAPACITY 16U
+#define CLIST_GROWTH_FACTOR    2U
+
+typedef struct compact_list_t
+{
+    void **values;
+    u32_t *prev;
+    u32_t *next;      // Also links the free slots
+    u32_t  head;
+    u32_t  tail;
+    u32_t  free_head; // First reusable slot, CLIST_NIL if none
+    u32_t  used;      // Slots ever handed out, [used, capacity) is untouched
+    u32_t  capacity;
+    size_t len;
+} compact_list_t;
+
+compact_list_t *clist_init(void);
+
+/*
+ * @brief Free the list and every value in it
+ */
+void clist_delete(compact_list_t *list);
+
+/*
+ * @brief Free the list but not the values (for clones that share values with another list)
+ */
+void clist_delete_shallow(compact_list_t *list);
+
+/*
+ * @brief Copy the whole arena with one memcpy per array. O(capacity)
+ * The clone shares the value pointers: release one of the two lists with clist_delete_shallow.
+ */
+compact_list_t *clist_clone(const compact_list_t *list);
+
+void clist_push_node(compact_list_t *list, void *data);
+
+void *clist_pop_head(compact_list_t *list);
+
+void *clist_pop_tail(compact_list_t *list);
+
+void clist_insert_node(compact_list_t *list, size_t index, void *data);
+
+void clist_remove_node(compact_list_t *list, size_t index);
+
+size_t clist_size(const compact_list_t *list);
+
+void *clist_get_element(const compact_list_t *list, size_t index);
+
+#endif // C_WORL_COMPACT_LIST_H
@@ -0,0 +1,84 @@
+/**
+ * @file concurrent_map.h
+ * @brief Thread safe u32 -> data map split into independently locked shards
+ *
+ * The key space is split over a power-of-two number of shards, each one a hash_map_sc_t behind
+ * its own reader-writer lock, so threads touching different shards never contend and readers of
+ * the same shard run in parallel. Every shard grows on its own, incrementally like any
+ * hash_map_sc_t, and only ever blocks the writers of that shard.
+ * Shards are cache line aligned so neighbouring locks do not share a line.
+ * The map owns the data pointers: they are freed on replace, remove and destroy, so a reader
+ * only sees a value inside cmap_get's callback, while the shard is read locked.
+ * Time: O(1) average get/put/remove plus one lock round trip
+ * Space: O(n + shards)
+ */
+
+#ifndef C_WORL_CONCURRENT_MAP_H
+#define C_WORL_CONCURRENT_MAP_H
+
+#include "hash_map.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#define CMAP_DEFAULT_SHARDS 64
+#define CMAP_CACHE_LINE     64
+
+// Opaque: the shards embed pthread_rwlock_t, only visible with POSIX feature macros
+typedef struct concurrent_map_t concurrent_map_t;
+
+/**
+ * @brief Create an empty map
+ * @param shard_count Shards, rounded up to a power of two (0 uses CMAP_DEFAULT_SHARDS)
+ * @return Pointer to the new map, exits on allocation failure
+ */
+concurrent_map_t *cmap_init(size_t shard_count);
+
+/**
+ * @brief Free every shard and its data, no other thread may still use the map
+ * @param map Pointer to the map (NULL is ignored)
+ */
+void cmap_destroy(concurrent_map_t *map);
+
+/**
+ * @brief Insert data under key, replacing (and freeing) the previous data of that key
+ * @param map Pointer to the map
+ * @param key Key
+ * @param data Heap data, owned by the map from now on
+ */
+void cmap_put(concurrent_map_t *map, u32_t key, void *data);
+
+/**
+ * @brief Run reader on the data of key while its shard is read locked
+ * @param map Pointer to the map
+ * @param key Key to find
+ * @param reader Called once with the key, its data and ctx if the key is present (may be NULL)
+ * @param ctx Passed through to reader
+ * @return true if the key is present
+ */
+bool cmap_get(concurrent_map_t *map, u32_t key, hash_map_visit_t reader, void *ctx);
+
+/**
+ * @brief Remove key and free its data
+ * @param map Pointer to the map
+ * @param key Key to remove
+ * @return true if the key was present
+ */
+bool cmap_remove(concurrent_map_t *map, u32_t key);
+
+/**
+ * @brief Entries over all shards, each shard is counted under its own lock so the total is
+ * only exact when no writer runs concurrently
+ * @param map Pointer to the map
+ * @return Number of entries
+ */
+size_t cmap_size(concurrent_map_t *map);
+
+/**
+ * @brief Number of shards
+ * @param map Pointer to the map
+ * @return Power of two shard count
+ */
+size_t cmap_shard_count(const concurrent_map_t *map);
+
+#endif // C_WORL_CONCURRENT_MAP_H
@@ -0,0 +1,103 @@
+/**
+ * @file deque.h
+ * @brief Double-ended queue on a contiguous ring buffer
+ *
+ * Elements live in one power-of-two buffer addressed as (head + index) & (capacity - 1), so
+ * both ends accept pushes and pops without shifting and without a node allocation per element.
+ * The buffer grows by DEQUE_GROWTH_FACTOR when full.
+ * Time: O(1) amortized push at both ends, O(1) pop at both ends, O(1) access
+ * Space: O(n)
+ */
+
+#ifndef C_WORL_DEQUE_H
+#define C_WORL_DEQUE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// Both must be powers of two so the index wraps with a mask
+#define DEQUE_INITIAL_CAPACITY 16
+#define DEQUE_GROWTH_FACTOR    2
+
+typedef struct deque_t
+{
+    void **data;
+    size_t head; // Physical index of element 0
+    size_t size;
+    size_t capacity;
+} deque_t;
+
+/**
+ * @brief Initialize a new deque
+ * @return Pointer to the new deque, exits on allocation failure
+ */
+deque_t *deque_init(void);
+
+/**
+ * @brief Free the deque (elements are not freed)
+ * @param deque Pointer to deque structure
+ */
+void deque_destroy(deque_t *deque);
+
+/**
+ * @brief Prepend an element. O(1) amortized
+ * @param deque Pointer to deque structure
+ * @param element Element to prepend
+ * @return true on success, false on allocation failure
+ */
+bool deque_push_front(deque_t *deque, void *element);
+
+/**
+ * @brief Append an element. O(1) amortized
+ * @param deque Pointer to deque structure
+ * @param element Element to append
+ * @return true on success, false on allocation failure
+ */
+bool deque_push_back(deque_t *deque, void *element);
+
+/**
+ * @brief Remove and return the first element. O(1)
+ * @param deque Pointer to deque structure
+ * @return First element, or NULL if empty
+ */
+void *deque_pop_front(deque_t *deque);
+
+/**
+ * @brief Remove and return the last element. O(1)
+ * @param deque Pointer to deque structure
+ * @return Last element, or NULL if empty
+ */
+void *deque_pop_back(deque_t *deque);
+
+/**
+ * @brief Get element at logical index (0 is the front). O(1)
+ * @param deque Pointer to deque structure
+ * @param index Index to access
+ * @return Element at index, or NULL if out of bounds
+ */
+void *deque_get(const deque_t *deque, size_t index);
+
+/**
+ * @brief Overwrite the element at logical index. O(1)
+ * @param deque Pointer to deque structure
+ * @param index Index to set
+ * @param element Element to store
+ * @return true on success, false if out of bounds
+ */
+bool deque_set(deque_t *deque, size_t index, void *element);
+
+/**
+ * @brief Get current size
+ * @param deque Pointer to deque structure
+ * @return Number of elements
+ */
+size_t deque_size(const deque_t *deque);
+
+/**
+ * @brief Check if deque is empty
+ * @param deque Pointer to deque structure
+ * @return true if empty
+ */
+bool deque_is_empty(const deque_t *deque);
+
+#endif // C_WORL_DEQUE_H
@@ -2,7 +2,11 @@
  * @file dynamic_array.h
  * @brief Generic dynamic array implementation
  *
- * A growable array that doubles capacity on overflow.
+ * A growable array that multiplies its capacity by DYNARRAY_GROWTH_FACTOR on overflow.
+ * The first DYNARRAY_INLINE_CAPACITY elements live in a buffer inside the struct itself, so
+ * short arrays never allocate their data and a dynamic_array_t can sit on the stack or be
+ * embedded in another struct (see dynarray_init_inline). Because data may point into the
+ * struct, never copy a dynamic_array_t by value.
  * Time: O(1) amortized append, O(1) access
  * Space: O(n)
  */
@@ -13,13 +17,26 @@
 #include <stdbool.h>
 #include <stddef.h>
 #define DYNARRAY_INITIAL_CAPACITY 16
-#define DYNARRAY_GROWTH_FACTOR    2
+
+// Slots stored inside the struct before spilling to the heap, override with -D
+#ifndef DYNARRAY_INLINE_CAPACITY
+#define DYNARRAY_INLINE_CAPACITY 8
+#endif
+
+// Multiplicative growth factor, override with -DDYNARRAY_GROWTH_FACTOR=<n> (n >= 2)
+#ifndef DYNARRAY_GROWTH_FACTOR
+#define DYNARRAY_GROWTH_FACTOR 2
+#endif
+#if DYNARRAY_GROWTH_FACTOR < 2
+#error "DYNARRAY_GROWTH_FACTOR must be at least 2"
+#endif
 
 typedef struct dynamic_array_t
 {
-    void **data;
+    void **data; // Points to inline_data until the array outgrows it
     size_t size;
     size_t capacity;
+    void  *inline_data[DYNARRAY_INLINE_CAPACITY];
 } dynamic_array_t;
 
 /**
@@ -30,7 +47,29 @@ typedef struct dynamic_array_t
 dynamic_array_t *dynarray_init(void);
 
 /**
- * @brief Free all memory associated with the array
+ * @brief Initialize a new dynamic array with room for at least capacity elements
+ * @param capacity Number of slots to preallocate (up to DYNARRAY_INLINE_CAPACITY only uses
+ * the inline buffer)
+ * @return Pointer to the new array, exits on allocation failure
+ */
+dynamic_array_t *dynarray_init_with_capacity(size_t capacity);
+
+/**
+ * @brief Initialize an array living in caller owned memory (stack or another struct)
+ * No allocation happens until more than DYNARRAY_INLINE_CAPACITY elements are pushed.
+ * Every dynarray_* function works on it; release it with dynarray_release, not destroy.
+ * @param arr Pointer to uninitialized array structure
+ */
+void dynarray_init_inline(dynamic_array_t *arr);
+
+/**
+ * @brief Free the heap buffer (if any) and leave the array empty and reusable
+ * @param arr Pointer to array structure
+ */
+void dynarray_release(dynamic_array_t *arr);
+
+/**
+ * @brief Free all memory associated with an array created by dynarray_init*
  * @param arr Pointer to array structure
  */
 void dynarray_destroy(dynamic_array_t *arr);
@@ -81,4 +120,66 @@ size_t dynarray_size(const dynamic_array_t *arr);
  */
 bool dynarray_is_empty(const dynamic_array_t *arr);
 
+/**
+ * @brief Get current capacity
+ * @param arr Pointer to array structure
+ * @return Number of slots allocated
+ */
+size_t dynarray_capacity(const dynamic_array_t *arr);
+
+/**
+ * @brief Make sure the array can hold at least capacity elements without reallocating
+ * O(n) time if it grows, O(1) otherwise
+ * @param arr Pointer to array structure
+ * @param capacity Minimum capacity wanted
+ * @return true on success, false on allocation failure
+ */
+bool dynarray_reserve(dynamic_array_t *arr, size_t capacity);
+
+/**
+ * @brief Release the unused slots so that capacity matches size
+ * @param arr Pointer to array structure
+ * @return true on success, false on allocation failure (array left untouched)
+ */
+bool dynarray_shrink_to_fit(dynamic_array_t *arr);
+
+/**
+ * @brief Insert count elements before index, shifting the tail once
+ * O(n + count) time, grows at most once
+ * @param arr Pointer to array structure
+ * @param index Position of the first inserted element (index == size appends)
+ * @param elements Elements to copy in, must not point into arr
+ * @param count Number of elements
+ * @return true on success, false if out of bounds or on allocation failure
+ */
+bool dynarray_insert_range(dynamic_array_t *arr, size_t index, void *const *elements, size_t count);
+
+/**
+ * @brief Remove count elements starting at index, shifting the tail once
+ * O(n) time. The removed elements are not freed.
+ * @param arr Pointer to array structure
+ * @param index Position of the first removed element
+ * @param count Number of elements
+ * @return true on success, false if the range is out of bounds
+ */
+bool dynarray_erase_range(dynamic_array_t *arr, size_t index, size_t count);
+
+/**
+ * @brief Append count elements at the end
+ * O(count) time, grows at most once
+ * @param arr Pointer to array structure
+ * @param elements Elements to copy in, must not point into arr
+ * @param count Number of elements
+ * @return true on success, false on allocation failure
+ */
+bool dynarray_push_n(dynamic_array_t *arr, void *const *elements, size_t count);
+
+/**
+ * @brief Append every element of other at the end of arr (arr == other is allowed)
+ * @param arr Pointer to destination array
+ * @param other Pointer to source array
+ * @return true on success, false on allocation failure
+ */
+bool dynarray_append_array(dynamic_array_t *arr, const dynamic_array_t *other);
+
 #endif /* DYNAMIC_ARRAY_H */
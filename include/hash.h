@@ -0,0 +1,66 @@
+/**
+ * @file hash.h
+ * @brief Hash functions for integer and byte keys
+ *
+ * Byte hashes share one signature so a map can take any of them as a parameter:
+ *   hash_fnv1a     FNV-1a, one xor and one multiply per byte. Short keys, simple and portable
+ *   hash_djb2      Bernstein's h * 33 + c, one byte at a time. Weakest mixing of the three
+ *   hash_murmur64a MurmurHash64A, eight bytes per step through unaligned-safe word loads.
+ *                  Fastest past a few words, the default for byte-keyed maps
+ * The seed perturbs the starting state, 0 gives the published reference values.
+ * hash_mix32 is the integer finalizer the u32-keyed maps index with.
+ */
+
+#ifndef C_WORL_HASH_H
+#define C_WORL_HASH_H
+
+#include "utils.h"
+
+#include <stddef.h>
+
+typedef u64_t (*hash_fn_t)(const void *key, size_t len, u64_t seed);
+
+/**
+ * @brief Finalizer of murmur3: every input bit affects every output bit, so the low bits are
+ * usable as a table index even for sequential keys
+ * @param key Key to mix
+ * @return Mixed 32-bit hash
+ */
+static inline u32_t hash_mix32(u32_t key)
+{
+    key ^= key >> 16;
+    key *= 0x85EBCA6BU;
+    key ^= key >> 13;
+    key *= 0xC2B2AE35U;
+    key ^= key >> 16;
+    return key;
+}
+
+/**
+ * @brief 64-bit FNV-1a. O(len)
+ * @param key Bytes to hash
+ * @param len Number of bytes
+ * @param seed Xored into the offset basis
+ * @return 64-bit hash
+ */
+u64_t hash_fnv1a(const void *key, size_t len, u64_t seed);
+
+/**
+ * @brief djb2 (xor variant) widened to 64 bits. O(len)
+ * @param key Bytes to hash
+ * @param len Number of bytes
+ * @param seed Xored into the initial 5381
+ * @return 64-bit hash
+ */
+u64_t hash_djb2(const void *key, size_t len, u64_t seed);
+
+/**
+ * @brief MurmurHash64A, word at a time. O(len / 8)
+ * @param key Bytes to hash, any alignment
+ * @param len Number of bytes
+ * @param seed Murmur seed
+ * @return 64-bit hash
+ */
+u64_t hash_murmur64a(const void *key, size_t len, u64_t seed);
+
+#endif // C_WORL_HASH_H
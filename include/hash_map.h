@@ -2,7 +2,9 @@
 // Created by hectoralv22 on 1/7/26.
 //
 
+#include "hash.h"
 #include "linked_list.h"
+#include "pool.h"
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -10,7 +12,29 @@
 #ifndef C_WORL_HASH_MAP_H
 #define C_WORL_HASH_MAP_H
 
-#define HASH_MAP_THRESHOLD 0.75
+#define HASH_MAP_THRESHOLD        0.75
+#define HASH_MAP_INITIAL_CAPACITY 16 // Power of two, every table indexes with hash & (capacity - 1)
+#define HASH_MAP_GROWTH_FACTOR    2
+
+// Old buckets moved per add/remove while the chaining map grows. Doubling starts at 0.75 load
+// and the next one at 1.5x the entries, so any step >= 2 drains the old table in time
+#ifndef HASH_MAP_MIGRATE_STEP
+#define HASH_MAP_MIGRATE_STEP 4
+#endif
+
+// Keys a batch call prefetches ahead before resolving them, enough misses in flight to cover
+// memory latency without evicting the first lines before they are used
+#ifndef HASH_MAP_BATCH
+#define HASH_MAP_BATCH 16
+#endif
+
+// -DHASH_MAP_STATS (make STATS=1) compiles in per-map probe and resize counters. Off by default
+// so lookups stay untouched, every translation unit must agree since each map gains a field
+#define HASH_MAP_STATS_BINS 16 // Histogram bins, the last one also counts every longer length
+
+#ifdef HASH_MAP_STATS
+typedef struct hash_map_counters_t hash_map_counters_t; // Private to hash_map.c
+#endif
 
 typedef struct entry_t
 {
@@ -30,27 +54,210 @@ typedef struct mod_ll_t
     entry_t *head;
     entry_t *tail;
     size_t   len;
+    pool_t  *pool; // Entry allocator shared by the buckets of a map, NULL means malloc/free
 } mod_ll_t;
 
 
 // CASE SEPARATE CHAINING
+/*
+ * @brief Growth is incremental: past HASH_MAP_THRESHOLD a table twice as big becomes current,
+ * and each add/remove moves HASH_MAP_MIGRATE_STEP buckets out of the old one, so no single
+ * operation pays for the whole rehash. Lookups check both tables until the old one is empty.
+ */
 typedef struct hash_map_sc_t
 {
-    mod_ll_t **buckets;
+    mod_ll_t **buckets;      // Created on first use, NULL while empty
+    mod_ll_t **old_buckets;  // Table being drained, NULL when no migration is running
+    pool_t    *entries;      // Shared allocator of every bucket's entries
     size_t     capacity;
+    size_t     old_capacity;
+    size_t     migrate_pos;  // Next old bucket to move, those below are already empty
     size_t     size;
-    float      load_factor;
+    float      load_factor;  // size / capacity of the current table
+#ifdef HASH_MAP_STATS
+    hash_map_counters_t *counters; // Behind a pointer so lookups on a const map still count
+#endif
 } hash_map_sc_t;
 
 // CASE OPEN ADDRESSING
+/*
+ * @brief One slot of the open addressing table. dist is the probe distance from the home slot
+ * plus one, so 0 marks an empty slot.
+ */
+typedef struct oa_slot_t
+{
+    u32_t key;
+    u32_t dist;
+    void *data;
+} oa_slot_t;
+
+/*
+ * @brief Flat table with linear probing and Robin Hood displacement: an insert takes the slot
+ * of any entry closer to its home than the new one, so probe lengths stay short and even.
+ * Removal shifts the following entries back instead of leaving tombstones.
+ */
 typedef struct hash_map_oa_t
 {
-    mod_ll_t **buckets;
+    oa_slot_t *slots;
     size_t     capacity;
     size_t     size;
     float      load_factor;
+#ifdef HASH_MAP_STATS
+    hash_map_counters_t *counters; // Behind a pointer so lookups on a const map still count
+#endif
 } hash_map_oa_t;
 
+// CASE CONTROL BYTES (SIMD GROUP PROBING)
+#define HASH_MAP_SIMD_THRESHOLD 0.875 // Group probing keeps misses short up to 7/8 full
+
+typedef struct simd_slot_t
+{
+    u32_t key;
+    void *data;
+} simd_slot_t;
+
+/*
+ * @brief Open addressing with one control byte per slot kept in its own array: the low 7 bits
+ * of the hash for a full slot, or an empty/deleted marker. A probe loads a whole group of
+ * control bytes (16 with SSE2, 32 with AVX2, scalar loop elsewhere) and compares them at once,
+ * so slots are only touched on a 7-bit tag match and a miss usually ends in the first group.
+ */
+typedef struct hash_map_simd_t
+{
+    u8_t        *ctrl;       // capacity + group width bytes, the tail mirrors the first group
+    simd_slot_t *slots;
+    size_t       capacity;
+    size_t       size;
+    size_t       tombstones; // Deleted slots, they count towards the load until the next rehash
+    float        load_factor;
+#ifdef HASH_MAP_STATS
+    hash_map_counters_t *counters; // Behind a pointer so lookups on a const map still count
+#endif
+} hash_map_simd_t;
+
+// CASE FLAT CHAINING
+#define HASH_MAP_FC_NIL UINT32_MAX
+
+/*
+ * @brief Chained entry addressed by index. In the bucket array an entry with data == NULL
+ * is an empty bucket, so stored data must not be NULL.
+ */
+typedef struct fc_entry_t
+{
+    u32_t key;
+    u32_t next; // Overflow index of the next entry in the chain, HASH_MAP_FC_NIL ends it
+    void *data;
+} fc_entry_t;
+
+/*
+ * @brief Separate chaining without a heap node per bucket: the first entry of every chain
+ * lives inline in the bucket array and collisions go to one shared overflow array linked by
+ * 32-bit indexes, so a hit on the first entry costs a single cache miss.
+ */
+typedef struct hash_map_fc_t
+{
+    fc_entry_t *buckets;
+    fc_entry_t *overflow;
+    u32_t       overflow_free;     // Head of the released overflow entries, linked through next
+    size_t      overflow_used;     // Overflow entries ever handed out (high water mark)
+    size_t      overflow_capacity;
+    size_t      capacity;
+    size_t      size;
+    float       load_factor;
+#ifdef HASH_MAP_STATS
+    hash_map_counters_t *counters; // Behind a pointer so lookups on a const map still count
+#endif
+} hash_map_fc_t;
+
+// CASE DENSE (INSERTION ORDERED)
+typedef struct dense_entry_t
+{
+    u32_t key;
+    void *data; // NULL marks a removed entry until the next compaction
+} dense_entry_t;
+
+/*
+ * @brief Entries packed in insertion order in one array, found through a separate open
+ * addressing table of indexes into it. The index width follows the capacity: 1 byte up to
+ * 254 entries, 2 bytes up to 65534, 4 bytes beyond, the two top values of each width mark
+ * empty and removed slots. Iteration is a linear scan of the entries and a compacted map is
+ * a single contiguous block.
+ */
+typedef struct hash_map_dense_t
+{
+    dense_entry_t *entries;
+    void          *indices;          // index_capacity slots of index_width bytes
+    size_t         used;             // Entries appended so far, removed ones included
+    size_t         entries_capacity; // index_capacity * HASH_MAP_THRESHOLD
+    size_t         index_capacity;
+    size_t         index_width;
+    size_t         size;
+    float          load_factor;
+#ifdef HASH_MAP_STATS
+    hash_map_counters_t *counters; // Behind a pointer so lookups on a const map still count
+#endif
+} hash_map_dense_t;
+
+// CASE BYTE KEYS
+typedef struct bytes_entry_t
+{
+    struct bytes_entry_t *next;
+    u64_t                 hash;    // Full hash: compared before the key bytes, reused on resize
+    void                 *data;
+    size_t                key_len;
+    byte_t                key[];   // Private copy of the key, allocated with the entry
+} bytes_entry_t;
+
+/*
+ * @brief Separate chaining over arbitrary byte keys (strings, blobs) with the hash function
+ * chosen per map. Chains are singly linked and every entry caches its full hash.
+ */
+typedef struct hash_map_bytes_t
+{
+    bytes_entry_t **buckets;
+    hash_fn_t       hash;
+    u64_t           seed;
+    size_t          capacity;
+    size_t          size;
+    float           load_factor;
+#ifdef HASH_MAP_STATS
+    hash_map_counters_t *counters; // Behind a pointer so lookups on a const map still count
+#endif
+} hash_map_bytes_t;
+
+/*
+ * @brief Callback for the for_each_entry_* iterations
+ */
+typedef void (*hash_map_visit_t)(u32_t key, void *data, void *ctx);
+
+typedef void (*hash_map_bytes_visit_t)(const void *key, size_t key_len, void *data, void *ctx);
+
+/*
+ * @brief Health of one map, filled by the stats_* functions. The shape of the table is measured
+ * on every call. The counters are only kept with HASH_MAP_STATS, otherwise they read zero and
+ * counting is false.
+ *
+ * A probe is one key compared or slot read: the entries walked along a chain for the chaining
+ * maps (0 on an empty bucket), the slots read for oa and dense, the control groups loaded for
+ * simd. Each get/add/remove search is one lookup. length_histogram[i] counts the buckets with
+ * a chain of i entries (sc, fc, bytes) or the entries stored i slots (oa, dense) or groups
+ * (simd) past their home. A bad hash shows as a long tail in both histograms.
+ */
+typedef struct hash_map_stats_t
+{
+    size_t size;
+    size_t capacity;
+    float  load_factor;
+    size_t length_histogram[HASH_MAP_STATS_BINS];
+    size_t max_length;
+    bool   counting;
+    u64_t  lookups;
+    u64_t  probes;
+    u64_t  probe_histogram[HASH_MAP_STATS_BINS]; // Lookups by probe count
+    u64_t  resizes;                              // Rehashes, in place purges included
+    u64_t  rehash_ns;                            // Wall time spent in them
+} hash_map_stats_t;
+
 /* ================================================================================================
  * ================================================================================================
  * ================================================================================================
@@ -64,6 +271,12 @@ typedef struct hash_map_oa_t
 
 mod_ll_t *mod_init_linked_list(void);
 
+/*
+ * @brief Create a bucket list whose entries come from pool (sizeof(entry_t) objects).
+ * The pool is not owned, it must outlive the list.
+ */
+mod_ll_t *mod_init_linked_list_pooled(pool_t *pool);
+
 void mod_delete_linked_list(mod_ll_t *list);
 
 void mod_push_entry(mod_ll_t *list, void *data);
@@ -80,16 +293,238 @@ void *rec_mod_get_element(entry_t *actual, size_t index);
 
 entry_t *create_entry(void *data);
 
+/*
+ * @brief Unlink entry from list without freeing it. O(1)
+ */
+void mod_detach_entry(mod_ll_t *list, entry_t *entry);
+
+/*
+ * @brief Append an already allocated, unlinked entry at the tail of list. O(1)
+ */
+void mod_attach_entry(mod_ll_t *list, entry_t *entry);
+
+/*
+ * @brief Insert an already allocated, unlinked entry at the head of list. O(1)
+ */
+void mod_attach_head(mod_ll_t *list, entry_t *entry);
 
 
 
 
+
+/* ================================================================================================
+ * SEPARATE CHAINING. The map owns the data pointers: they are freed on replace, remove and delete.
+ * O(1) average get/add/remove, including while the table grows.
+ * ================================================================================================
+ */
+
+/*
+ * @brief Finish growing now: start a migration to a bucket array HASH_MAP_GROWTH_FACTOR times
+ * bigger if none is running, then move every remaining old bucket. O(n)
+ */
 void load_value_sc(hash_map_sc_t *hash_map);
 
 hash_map_sc_t *init_hash_map(void);
 
 void delete_hash_map_sc(hash_map_sc_t *hash_map);
 
-void add_entry_sc(hash_map_sc_t *hash_map, void *data);
+/*
+ * @brief Insert data under key, replacing (and freeing) the previous data of that key
+ */
+void add_entry_sc(hash_map_sc_t *hash_map, u32_t key, void *data);
+
+/*
+ * @brief Data stored under key, NULL if absent
+ */
+void *get_entry_sc(const hash_map_sc_t *hash_map, u32_t key);
+
+/*
+ * @brief Remove key and free its data
+ * @return true if the key was present
+ */
+bool remove_entry_sc(hash_map_sc_t *hash_map, u32_t key);
+
+void for_each_entry_sc(const hash_map_sc_t *hash_map, hash_map_visit_t visit, void *ctx);
+
+/*
+ * @brief out[i] = get_entry_sc(hash_map, keys[i]) for every i < n. Keys are taken
+ * HASH_MAP_BATCH at a time: the bucket slots, bucket headers and first entries of the whole
+ * group are prefetched one level per pass, so the group's cache misses overlap instead of
+ * running one dependent chain after the other
+ */
+void get_batch_sc(const hash_map_sc_t *hash_map, const u32_t *keys, size_t n, void **out);
+
+/*
+ * @brief add_entry_sc(hash_map, keys[i], data[i]) in order, prefetching the buckets of each
+ * HASH_MAP_BATCH group first
+ */
+void add_batch_sc(hash_map_sc_t *hash_map, const u32_t *keys, void *const *data, size_t n);
+
+/* ================================================================================================
+ * OPEN ADDRESSING. Same contract as the separate chaining functions.
+ * ================================================================================================
+ */
+
+/*
+ * @brief Reinsert every entry into a slot array HASH_MAP_GROWTH_FACTOR times bigger. O(n)
+ */
+void load_value_oa(hash_map_oa_t *hash_map);
+
+hash_map_oa_t *init_hash_map_oa(void);
+
+void delete_hash_map_oa(hash_map_oa_t *hash_map);
+
+void add_entry_oa(hash_map_oa_t *hash_map, u32_t key, void *data);
+
+void *get_entry_oa(const hash_map_oa_t *hash_map, u32_t key);
+
+bool remove_entry_oa(hash_map_oa_t *hash_map, u32_t key);
+
+void for_each_entry_oa(const hash_map_oa_t *hash_map, hash_map_visit_t visit, void *ctx);
+
+/*
+ * @brief out[i] = get_entry_oa(hash_map, keys[i]) for every i < n, prefetching the home slots
+ * of each HASH_MAP_BATCH group before probing them
+ */
+void get_batch_oa(const hash_map_oa_t *hash_map, const u32_t *keys, size_t n, void **out);
+
+void add_batch_oa(hash_map_oa_t *hash_map, const u32_t *keys, void *const *data, size_t n);
+
+/* ================================================================================================
+ * CONTROL BYTES. Same contract as the separate chaining functions, grows past
+ * HASH_MAP_SIMD_THRESHOLD counting tombstones.
+ * ================================================================================================
+ */
+
+/*
+ * @brief Rehash into a table twice as big, or the same size when most of the load is
+ * tombstones. O(n)
+ */
+void load_value_simd(hash_map_simd_t *hash_map);
+
+hash_map_simd_t *init_hash_map_simd(void);
+
+void delete_hash_map_simd(hash_map_simd_t *hash_map);
+
+void add_entry_simd(hash_map_simd_t *hash_map, u32_t key, void *data);
+
+void *get_entry_simd(const hash_map_simd_t *hash_map, u32_t key);
+
+bool remove_entry_simd(hash_map_simd_t *hash_map, u32_t key);
+
+void for_each_entry_simd(const hash_map_simd_t *hash_map, hash_map_visit_t visit, void *ctx);
+
+/* ================================================================================================
+ * FLAT CHAINING. Same contract as the separate chaining functions, NULL data exits the program.
+ * ================================================================================================
+ */
+
+/*
+ * @brief Reinsert every entry into a bucket array HASH_MAP_GROWTH_FACTOR times bigger with a
+ * fresh overflow array. O(n)
+ */
+void load_value_fc(hash_map_fc_t *hash_map);
+
+hash_map_fc_t *init_hash_map_fc(void);
+
+void delete_hash_map_fc(hash_map_fc_t *hash_map);
+
+void add_entry_fc(hash_map_fc_t *hash_map, u32_t key, void *data);
+
+void *get_entry_fc(const hash_map_fc_t *hash_map, u32_t key);
+
+bool remove_entry_fc(hash_map_fc_t *hash_map, u32_t key);
+
+void for_each_entry_fc(const hash_map_fc_t *hash_map, hash_map_visit_t visit, void *ctx);
+
+/* ================================================================================================
+ * DENSE. Same contract as the separate chaining functions, NULL data exits the program.
+ * Iteration follows insertion order, replacing a key keeps its position.
+ * ================================================================================================
+ */
+
+/*
+ * @brief Compact the entries and rebuild the index table, twice as big unless removed
+ * entries were taking most of the room. O(n)
+ */
+void load_value_dense(hash_map_dense_t *hash_map);
+
+hash_map_dense_t *init_hash_map_dense(void);
+
+void delete_hash_map_dense(hash_map_dense_t *hash_map);
+
+void add_entry_dense(hash_map_dense_t *hash_map, u32_t key, void *data);
+
+void *get_entry_dense(const hash_map_dense_t *hash_map, u32_t key);
+
+bool remove_entry_dense(hash_map_dense_t *hash_map, u32_t key);
+
+void for_each_entry_dense(const hash_map_dense_t *hash_map, hash_map_visit_t visit, void *ctx);
+
+/*
+ * @brief Squeeze out removed entries in place, keeping the order, and reindex. O(n)
+ */
+void compact_dense(hash_map_dense_t *hash_map);
+
+/*
+ * @brief The size entries in insertion order as one contiguous block (compacts first when
+ * entries were removed), so a snapshot is a single memcpy of size * sizeof(dense_entry_t).
+ * Valid until the next add or remove
+ */
+const dense_entry_t *entries_dense(hash_map_dense_t *hash_map);
+
+/* ================================================================================================
+ * BYTE KEYS. Same contract as the separate chaining functions, the key bytes are copied.
+ * ================================================================================================
+ */
+
+/*
+ * @brief Relink every entry into a bucket array HASH_MAP_GROWTH_FACTOR times bigger using the
+ * cached hashes, no key is hashed again. O(n)
+ */
+void load_value_bytes(hash_map_bytes_t *hash_map);
+
+/*
+ * @brief Empty byte-keyed map
+ * @param hash Hash function of the map, NULL selects hash_murmur64a
+ * @param seed Seed passed to every hash call
+ */
+hash_map_bytes_t *init_hash_map_bytes(hash_fn_t hash, u64_t seed);
+
+void delete_hash_map_bytes(hash_map_bytes_t *hash_map);
+
+void add_entry_bytes(hash_map_bytes_t *hash_map, const void *key, size_t key_len, void *data);
+
+void *get_entry_bytes(const hash_map_bytes_t *hash_map, const void *key, size_t key_len);
+
+bool remove_entry_bytes(hash_map_bytes_t *hash_map, const void *key, size_t key_len);
+
+void for_each_entry_bytes(const hash_map_bytes_t *hash_map, hash_map_bytes_visit_t visit,
+                          void *ctx);
+
+/* ================================================================================================
+ * STATISTICS. O(capacity) scan of the table plus a copy of the counters (HASH_MAP_STATS).
+ * ================================================================================================
+ */
+
+void stats_sc(const hash_map_sc_t *hash_map, hash_map_stats_t *stats);
+
+void stats_oa(const hash_map_oa_t *hash_map, hash_map_stats_t *stats);
+
+void stats_simd(const hash_map_simd_t *hash_map, hash_map_stats_t *stats);
+
+void stats_fc(const hash_map_fc_t *hash_map, hash_map_stats_t *stats);
+
+void stats_dense(const hash_map_dense_t *hash_map, hash_map_stats_t *stats);
+
+void stats_bytes(const hash_map_bytes_t *hash_map, hash_map_stats_t *stats);
+
+/*
+ * @brief Human readable report: load, resizes, mean probes and both histograms side by side
+ * @param out Stream to write to
+ * @param name Label of the map
+ * @param stats Filled by one of the stats_* functions
+ */
+void print_hash_map_stats(FILE *out, const char *name, const hash_map_stats_t *stats);
 
 #endif // C_WORL_HASH_MAP_H
@@ -0,0 +1,133 @@
+/**
+ * @file hash_map_snapshot.h
+ * @brief Frozen byte-keyed hash map written to a file and served straight from an mmap
+ *
+ * A builder collects key/value byte strings and writes them as one position independent file:
+ *
+ *     header   snapshot_header_t, magic, version and the offsets/sizes of the sections below
+ *     slots    slot_count snapshot_slot_t, open addressing table (linear probing) of
+ *              {full 64-bit hash, heap offset of the record}, slot_count a power of two
+ *     heap     records {u32 key_len, u32 value_len, key bytes, value bytes}, 8-byte aligned
+ *
+ * Every reference is an offset, so snapshot_open only maps the file and checks the header:
+ * nothing is deserialized, startup is O(1) whatever the size, and processes that open the
+ * same file share its pages through the page cache. Lookups hash with hash_murmur64a and the
+ * seed from the header, and compare the cached hash before the key bytes.
+ * Integers are stored in host byte order, a snapshot is read on the architecture that wrote it.
+ * Time: O(n) build and write, O(1) open, O(1) average lookup
+ * Space: 16 bytes per slot (slots / entries <= 1 / HASH_MAP_THRESHOLD) plus the records
+ */
+
+#ifndef C_WORL_HASH_MAP_SNAPSHOT_H
+#define C_WORL_HASH_MAP_SNAPSHOT_H
+
+#include "hash_map.h"
+#include "utils.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#define SNAPSHOT_MAGIC       "CWSNAP\r\n" // 8 bytes, the CR LF catches text mode mangling
+#define SNAPSHOT_MAGIC_SIZE  8
+#define SNAPSHOT_VERSION     1U
+#define SNAPSHOT_SEED        0x5EED5EEDULL
+#define SNAPSHOT_EMPTY_SLOT  UINT64_MAX
+#define SNAPSHOT_ALIGNMENT   8U
+
+typedef struct snapshot_header_t
+{
+    char  magic[SNAPSHOT_MAGIC_SIZE];
+    u32_t version;
+    u32_t header_size;
+    u64_t seed;
+    u64_t entry_count;
+    u64_t slot_count;
+    u64_t slots_offset;
+    u64_t heap_offset;
+    u64_t heap_size;
+} snapshot_header_t;
+
+typedef struct snapshot_slot_t
+{
+    u64_t hash;
+    u64_t record; // Heap offset of the record, SNAPSHOT_EMPTY_SLOT when unused
+} snapshot_slot_t;
+
+typedef struct snapshot_builder_t
+{
+    hash_map_bytes_t *entries; // Key -> private copy of the value, deduplicates keys
+} snapshot_builder_t;
+
+typedef struct hash_map_snapshot_t
+{
+    const byte_t            *base;   // Start of the mapping
+    size_t                   length; // Bytes mapped
+    const snapshot_header_t *header;
+    const snapshot_slot_t   *slots;
+    const byte_t            *heap;
+} hash_map_snapshot_t;
+
+/**
+ * @brief Create an empty builder
+ * @return Pointer to the new builder, exits on allocation failure
+ */
+snapshot_builder_t *snapshot_builder_init(void);
+
+/**
+ * @brief Free the builder and the copies it holds
+ * @param builder Pointer to the builder (NULL is ignored)
+ */
+void snapshot_builder_destroy(snapshot_builder_t *builder);
+
+/**
+ * @brief Copy one key/value pair into the builder, a repeated key replaces the earlier value
+ * @param builder Pointer to the builder
+ * @param key Key bytes
+ * @param key_len Key length, at most UINT32_MAX
+ * @param value Value bytes
+ * @param value_len Value length, at most UINT32_MAX
+ */
+void snapshot_builder_add(snapshot_builder_t *builder, const void *key, size_t key_len,
+                          const void *value, size_t value_len);
+
+/**
+ * @brief Write the snapshot to path.tmp, fsync it and rename it over path. O(n)
+ * Processes that still map the previous file keep reading it until they close it.
+ * @param builder Pointer to the builder, left unchanged
+ * @param path Output file
+ * @return true on success, false on an I/O error (reported on stderr)
+ */
+bool snapshot_builder_write(const snapshot_builder_t *builder, const char *path);
+
+/**
+ * @brief Map a snapshot file read-only and validate its header and section bounds. O(1)
+ * @param path Snapshot file
+ * @return Pointer to the snapshot, NULL if the file cannot be mapped or is not a valid snapshot
+ */
+hash_map_snapshot_t *snapshot_open(const char *path);
+
+/**
+ * @brief Unmap the file, every pointer returned by snapshot_get becomes invalid
+ * @param snapshot Pointer to the snapshot (NULL is ignored)
+ */
+void snapshot_close(hash_map_snapshot_t *snapshot);
+
+/**
+ * @brief Find key in the mapping
+ * @param snapshot Pointer to the snapshot
+ * @param key Key bytes
+ * @param key_len Key length
+ * @param value_len Receives the value length when found (may be NULL)
+ * @return Pointer to the value bytes inside the mapping, NULL if absent or the record is corrupt
+ */
+const void *snapshot_get(const hash_map_snapshot_t *snapshot, const void *key, size_t key_len,
+                         size_t *value_len);
+
+/**
+ * @brief Number of entries
+ * @param snapshot Pointer to the snapshot
+ * @return Entry count from the header
+ */
+size_t snapshot_size(const hash_map_snapshot_t *snapshot);
+
+#endif // C_WORL_HASH_MAP_SNAPSHOT_H
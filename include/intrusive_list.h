@@ -0,0 +1,82 @@
+/**
+ * @file intrusive_list.h
+ * @brief Doubly linked list whose links live inside the user's own structs
+ *
+ * Embed an ilist_link_t in a struct and link that member; ILIST_CONTAINER_OF gets the struct
+ * back from a link. The list never allocates and never frees: the objects belong to the
+ * caller, and an object can sit on as many lists as it has link members.
+ *
+ *     typedef struct job_t { int id; ilist_link_t queue_link; ilist_link_t owner_link; } job_t;
+ *     ilist_push_tail(&queue, &job->queue_link);
+ *     job_t *first = ILIST_CONTAINER_OF(queue.head, job_t, queue_link);
+ *
+ * Time: O(1) push, pop, insert and remove, O(min(i, n - i)) get
+ * Space: two pointers per link member, no allocation
+ */
+
+#ifndef C_WORL_INTRUSIVE_LIST_H
+#define C_WORL_INTRUSIVE_LIST_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#define ILIST_CONTAINER_OF(ptr, type, member)                                                      \
+    ((type *) (void *) ((char *) (ptr) - offsetof(type, member)))
+
+typedef struct ilist_link_t
+{
+    struct ilist_link_t *prev;
+    struct ilist_link_t *next;
+} ilist_link_t;
+
+typedef struct intrusive_list_t
+{
+    ilist_link_t *head;
+    ilist_link_t *tail;
+    size_t        len;
+} intrusive_list_t;
+
+/**
+ * @brief Initialize an empty list in caller owned memory
+ */
+void ilist_init(intrusive_list_t *list);
+
+void ilist_push_head(intrusive_list_t *list, ilist_link_t *link);
+
+void ilist_push_tail(intrusive_list_t *list, ilist_link_t *link);
+
+/**
+ * @brief Unlink and return the first link, NULL if the list is empty
+ */
+ilist_link_t *ilist_pop_head(intrusive_list_t *list);
+
+/**
+ * @brief Unlink and return the last link, NULL if the list is empty
+ */
+ilist_link_t *ilist_pop_tail(intrusive_list_t *list);
+
+/**
+ * @brief Link link right before at (at NULL appends)
+ */
+void ilist_insert_before(intrusive_list_t *list, ilist_link_t *at, ilist_link_t *link);
+
+/**
+ * @brief Link link right after at (at NULL prepends)
+ */
+void ilist_insert_after(intrusive_list_t *list, ilist_link_t *at, ilist_link_t *link);
+
+/**
+ * @brief Unlink a link that is on this list, the object itself is untouched
+ */
+void ilist_remove(intrusive_list_t *list, ilist_link_t *link);
+
+/**
+ * @brief Link at index walking from the nearer end, NULL if out of bounds
+ */
+ilist_link_t *ilist_get(const intrusive_list_t *list, size_t index);
+
+size_t ilist_size(const intrusive_list_t *list);
+
+bool ilist_is_empty(const intrusive_list_t *list);
+
+#endif // C_WORL_INTRUSIVE_LIST_H
@@ -2,6 +2,7 @@
 // Created by hectoralv22 on 1/4/26.
 //
 
+#include "pool.h"
 #include "utils.h"
 
 #include <stdbool.h>
@@ -23,10 +24,38 @@ typedef struct linked_list_t
     node_t *head;
     node_t *tail;
     size_t  len;
+    pool_t *pool;      // Node allocator, NULL means malloc/free per node
+    bool    owns_pool; // Pool created by the list and destroyed with it
 } linked_list_t;
 
+/*
+ * @brief Order of two values: negative, zero or positive like strcmp
+ */
+typedef int (*list_cmp_t)(const void *a, const void *b);
+
+/*
+ * @brief Position in a linked list. node == NULL is the end position, which sits between the
+ * tail and the head: index is then len, next moves to the head and prev to the tail.
+ * Only operations through the cursor keep it valid, any other change to the list may leave
+ * it dangling.
+ */
+typedef struct list_cursor_t
+{
+    linked_list_t *list;
+    node_t        *node;
+    size_t         index;
+} list_cursor_t;
+
 linked_list_t *init_linkedlist(void);
 
+/*
+ * @brief Create a list whose nodes come from a slab pool instead of malloc
+ * @param pool Pool of sizeof(node_t) objects shared with other lists, or NULL to give the list
+ * a private pool. A private pool is dropped slab by slab in delete_linkedlist, a shared pool
+ * must outlive the list.
+ */
+linked_list_t *init_linkedlist_pooled(pool_t *pool);
+
 node_t *create_node(void *data);
 
 void delete_linkedlist(linked_list_t *list);
@@ -47,4 +76,71 @@ void *get_element(linked_list_t *list, size_t index);
 
 void *rec_get_element(node_t *actual, size_t index);
 
+/* ================================================================================================
+ * CURSORS. Every operation is O(1) except list_cursor_at, O(min(i, n - i)).
+ * ================================================================================================
+ */
+
+list_cursor_t list_cursor_front(linked_list_t *list);
+
+list_cursor_t list_cursor_back(linked_list_t *list);
+
+list_cursor_t list_cursor_at(linked_list_t *list, size_t index);
+
+bool list_cursor_valid(const list_cursor_t *cursor);
+
+size_t list_cursor_index(const list_cursor_t *cursor);
+
+void *list_cursor_get(const list_cursor_t *cursor);
+
+void list_cursor_next(list_cursor_t *cursor);
+
+void list_cursor_prev(list_cursor_t *cursor);
+
+/*
+ * @brief Insert before the cursor (at the end position this appends), cursor stays on its node
+ */
+void list_cursor_insert_before(list_cursor_t *cursor, void *data);
+
+/*
+ * @brief Insert after the cursor (at the end position this prepends), cursor stays on its node
+ */
+void list_cursor_insert_after(list_cursor_t *cursor, void *data);
+
+/*
+ * @brief Unlink the node under the cursor and move to the next one
+ * @return The removed value, now owned by the caller (like pop_head)
+ */
+void *list_cursor_remove(list_cursor_t *cursor);
+
+/* ================================================================================================
+ * SORT, MERGE, SPLICE AND SPLIT. Nodes are relinked in place, nothing is allocated or copied.
+ * Moving nodes between lists requires them to share their allocator (both malloc, or the same
+ * shared pool), otherwise throw_error is called.
+ * ================================================================================================
+ */
+
+/*
+ * @brief Stable bottom-up merge sort. O(n log n) time, O(1) extra space
+ */
+void list_sort(linked_list_t *list, list_cmp_t cmp);
+
+/*
+ * @brief Merge sorted src into sorted dst (stable, dst first on ties), src ends empty. O(n + m)
+ */
+void list_merge(linked_list_t *dst, linked_list_t *src, list_cmp_t cmp);
+
+/*
+ * @brief Move every node of src before the cursor (the end position appends), src ends
+ * empty. O(1)
+ */
+void list_splice(list_cursor_t *cursor, linked_list_t *src);
+
+/*
+ * @brief Detach the cursor node and everything after it into a new list. O(1)
+ * The cursor follows its node into the returned list. Lists owning a private pool cannot split.
+ * @return New list (possibly empty) sharing the allocator of the original
+ */
+linked_list_t *list_split(list_cursor_t *cursor);
+
 #endif // C_WORL_LINKED_LIST_H
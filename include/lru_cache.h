@@ -0,0 +1,145 @@
+/**
+ * @file lru_cache.h
+ * @brief Bounded least recently used cache: a hash map for lookups, a mod_ll_t for recency
+ *
+ * Every cached value sits in one lru_node_t that is both a node of the recency queue (most
+ * recent at the head) and the data of its key in a hash_map_oa_t. A get finds the node through
+ * the map and relinks it at the head, a put that goes over budget evicts from the tail, both
+ * O(1) with no allocation on the hit path. The budget is a number of entries, a number of
+ * bytes as reported by the caller on put, or both (0 leaves a bound off).
+ * The cache owns the values: they are freed on replace, eviction, remove and destroy.
+ *
+ * lru_sharded_t splits the key space over independently locked caches for multithreaded use.
+ * A get reorders the queue, so each shard takes a plain mutex rather than a read lock, and the
+ * budget is divided evenly: each shard evicts on its own, a skewed key set evicts a little
+ * earlier than one global LRU would. The shares add up to the total bounds exactly, so a single
+ * value must fit its shard's share: up to max_bytes / shard_count bytes is always accepted.
+ * Time: O(1) average get/put/remove (plus one lock round trip when sharded)
+ * Space: O(n), one node of sizeof(lru_node_t) and one map slot per entry
+ */
+
+#ifndef C_WORL_LRU_CACHE_H
+#define C_WORL_LRU_CACHE_H
+
+#include "hash_map.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#define LRU_DEFAULT_SHARDS 64
+
+typedef struct lru_node_t
+{
+    entry_t link;  // First member: the map frees the node through the entry pointer
+    size_t  bytes; // Size charged against max_bytes
+} lru_node_t;
+
+typedef struct lru_cache_t
+{
+    hash_map_oa_t *index;       // key -> node, owns the nodes
+    mod_ll_t      *order;       // Most recently used at the head, evicted from the tail
+    size_t         max_entries; // 0 for no entry bound
+    size_t         max_bytes;   // 0 for no byte bound
+    size_t         bytes;       // Sum of the bytes of the cached values
+    size_t         hits;
+    size_t         misses;
+    size_t         evictions;
+} lru_cache_t;
+
+// Opaque: the shards embed pthread_mutex_t, only visible with POSIX feature macros
+typedef struct lru_sharded_t lru_sharded_t;
+
+/**
+ * @brief Create an empty cache
+ * @param max_entries Entry bound (0 for none)
+ * @param max_bytes Byte bound (0 for none)
+ * @return Pointer to the new cache, exits on allocation failure
+ */
+lru_cache_t *lru_init(size_t max_entries, size_t max_bytes);
+
+/**
+ * @brief Free the cache and every value in it
+ * @param cache Pointer to the cache (NULL is ignored)
+ */
+void lru_destroy(lru_cache_t *cache);
+
+/**
+ * @brief Value of key, which becomes the most recently used. O(1)
+ * @param cache Pointer to the cache
+ * @param key Key to find
+ * @return Value (valid until the next put or remove), NULL on a miss
+ */
+void *lru_get(lru_cache_t *cache, u32_t key);
+
+/**
+ * @brief Insert or replace key as the most recently used, then evict from the tail until the
+ * cache is back within its bounds. O(1) amortized
+ * @param cache Pointer to the cache
+ * @param key Key
+ * @param value Heap value, owned by the cache from now on
+ * @param bytes Size charged for value against max_bytes
+ * @return false if bytes alone exceeds max_bytes: value is freed and nothing is cached
+ */
+bool lru_put(lru_cache_t *cache, u32_t key, void *value, size_t bytes);
+
+/**
+ * @brief Remove key and free its value
+ * @param cache Pointer to the cache
+ * @param key Key to remove
+ * @return true if the key was cached
+ */
+bool lru_remove(lru_cache_t *cache, u32_t key);
+
+/**
+ * @brief Create an empty sharded cache, the bounds are totals split evenly over the shards
+ * @param shard_count Shards, rounded up to a power of two (0 uses LRU_DEFAULT_SHARDS), then
+ * halved until it is at most max_entries and max_bytes when they are set
+ * @param max_entries Total entry bound (0 for none)
+ * @param max_bytes Total byte bound (0 for none)
+ * @return Pointer to the new cache, exits on allocation failure
+ */
+lru_sharded_t *lru_sharded_init(size_t shard_count, size_t max_entries, size_t max_bytes);
+
+/**
+ * @brief Free every shard and its values, no other thread may still use the cache
+ * @param cache Pointer to the cache (NULL is ignored)
+ */
+void lru_sharded_destroy(lru_sharded_t *cache);
+
+/**
+ * @brief Run reader on the value of key while its shard is locked, key becomes the most
+ * recently used of its shard
+ * @param cache Pointer to the cache
+ * @param key Key to find
+ * @param reader Called once with the key, its value and ctx on a hit (may be NULL)
+ * @param ctx Passed through to reader
+ * @return true on a hit
+ */
+bool lru_sharded_get(lru_sharded_t *cache, u32_t key, hash_map_visit_t reader, void *ctx);
+
+/**
+ * @brief lru_put on the shard of key, under its lock. It fails (freeing value) when bytes
+ * exceeds the share of max_bytes of that shard, which is at least max_bytes / shard_count
+ */
+bool lru_sharded_put(lru_sharded_t *cache, u32_t key, void *value, size_t bytes);
+
+/**
+ * @brief lru_remove on the shard of key, under its lock
+ */
+bool lru_sharded_remove(lru_sharded_t *cache, u32_t key);
+
+/**
+ * @brief Entries over all shards, each shard counted under its own lock
+ * @param cache Pointer to the cache
+ * @return Number of entries
+ */
+size_t lru_sharded_size(lru_sharded_t *cache);
+
+/**
+ * @brief Number of shards
+ * @param cache Pointer to the cache
+ * @return Power of two shard count
+ */
+size_t lru_sharded_shard_count(const lru_sharded_t *cache);
+
+#endif // C_WORL_LRU_CACHE_H
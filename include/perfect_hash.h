@@ -0,0 +1,111 @@
+/**
+ * @file perfect_hash.h
+ * @brief Minimal perfect hash (BBHash style) and a static map built on it
+ *
+ * mph_build maps a set of n distinct u32 keys onto [0, n) with no collision and no empty
+ * slot. Level i has a bit array of MPH_GAMMA times the keys still unplaced; every key hashes
+ * to one bit of it with the level's seed, keys alone on their bit set it and are done, keys
+ * that collide go down to the next level. A key's index is the number of set bits before its
+ * own across all levels, answered by a rank table sampled every MPH_RANK_WORDS words.
+ * Levels are built with several threads: they mark bits with atomic ors, then split out the
+ * colliding keys, each on its own share of the keys.
+ * perfect_map_t stores key and data in one entry array indexed by that hash, so a lookup
+ * touches the bit levels and then exactly one table slot, with no load factor slack.
+ * Time: O(n) expected build, O(1) lookup (1 / (1 - e^(-1/gamma)) levels on average)
+ * Space: about gamma * e^(1/gamma) bits per key for the hash (~3.7 with gamma 2)
+ */
+
+#ifndef C_WORL_PERFECT_HASH_H
+#define C_WORL_PERFECT_HASH_H
+
+#include "utils.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define MPH_GAMMA      2    // Bits per unplaced key at each level, more is faster but larger
+#define MPH_MAX_LEVELS 64   // Reaching it means the keys were not distinct
+#define MPH_RANK_WORDS 8    // 64-bit words between two rank samples
+#define MPH_NOT_FOUND  SIZE_MAX
+
+typedef struct perfect_hash_t
+{
+    u64_t *bits;                       // All levels back to back, each a whole number of words
+    u64_t *ranks;                      // Set bits before every MPH_RANK_WORDS block
+    size_t word_count;
+    size_t level_count;
+    size_t level_word[MPH_MAX_LEVELS]; // First word of each level
+    size_t level_bits[MPH_MAX_LEVELS]; // Bits of each level
+    size_t key_count;
+    u64_t  seed;
+} perfect_hash_t;
+
+typedef struct perfect_entry_t
+{
+    u32_t key; // entries[mph_lookup(k)].key == k for members, rejects other keys
+    void *data;
+} perfect_entry_t;
+
+typedef struct perfect_map_t
+{
+    perfect_hash_t  *hash;
+    perfect_entry_t *entries; // Key and data side by side, a lookup misses one cache line
+} perfect_map_t;
+
+/**
+ * @brief Build a minimal perfect hash of keys
+ * @param keys Distinct keys (not modified)
+ * @param count Number of keys
+ * @param threads Build threads (0 uses every online processor)
+ * @return Pointer to the hash, NULL if the keys contain duplicates. Exits on allocation failure
+ */
+perfect_hash_t *mph_build(const u32_t *keys, size_t count, size_t threads);
+
+/**
+ * @brief Free the hash
+ * @param hash Pointer to the hash (NULL is ignored)
+ */
+void mph_destroy(perfect_hash_t *hash);
+
+/**
+ * @brief Index of key. O(1)
+ * @param hash Pointer to the hash
+ * @param key Key to look up
+ * @return Index in [0, key_count) for every key of the build set, an arbitrary index or
+ * MPH_NOT_FOUND for any other key
+ */
+size_t mph_lookup(const perfect_hash_t *hash, u32_t key);
+
+/**
+ * @brief Bits of metadata per key, bit levels plus rank samples
+ * @param hash Pointer to the hash
+ * @return Bits per key
+ */
+double mph_bits_per_key(const perfect_hash_t *hash);
+
+/**
+ * @brief Build a static map, it owns the values from now on (freed by perfect_map_destroy)
+ * @param keys Distinct keys
+ * @param values values[i] is the data of keys[i]
+ * @param count Number of keys
+ * @param threads Build threads (0 uses every online processor)
+ * @return Pointer to the map, NULL if the keys contain duplicates (values are not taken)
+ */
+perfect_map_t *perfect_map_build(const u32_t *keys, void *const *values, size_t count,
+                                 size_t threads);
+
+/**
+ * @brief Free the map and its values
+ * @param map Pointer to the map (NULL is ignored)
+ */
+void perfect_map_destroy(perfect_map_t *map);
+
+/**
+ * @brief Data stored under key, NULL if key was not in the build set. O(1), one table probe
+ * @param map Pointer to the map
+ * @param key Key to look up
+ * @return Data or NULL
+ */
+void *perfect_map_get(const perfect_map_t *map, u32_t key);
+
+#endif // C_WORL_PERFECT_HASH_H
@@ -0,0 +1,76 @@
+/**
+ * @file pool.h
+ * @brief Fixed-size object pool carved out of large slabs
+ *
+ * Objects come from a free list of released objects first, then from a pointer bump in the
+ * newest slab; a new slab of objects_per_slab objects is malloc'd only when both run out.
+ * pool_free only pushes the object on the free list. pool_destroy releases every slab at
+ * once, so a container that owns its pool can drop all its nodes without walking them.
+ * Objects are aligned to POOL_ALIGNMENT.
+ * Time: O(1) alloc, O(1) free, O(slabs) destroy
+ * Space: O(peak live objects)
+ */
+
+#ifndef C_WORL_POOL_H
+#define C_WORL_POOL_H
+
+#include "utils.h"
+
+#include <stddef.h>
+
+#define POOL_ALIGNMENT            (sizeof(void *))
+#define POOL_DEFAULT_SLAB_OBJECTS 256
+
+typedef struct pool_slab_t
+{
+    struct pool_slab_t *next;
+    size_t              capacity; // Objects carved in this slab, they follow the header
+} pool_slab_t;
+
+typedef struct pool_t
+{
+    size_t       object_size;      // Requested size rounded up to POOL_ALIGNMENT
+    size_t       objects_per_slab;
+    pool_slab_t *slabs;            // Newest slab first
+    void        *free_list;        // Released objects, linked through their first word
+    byte_t      *bump;             // Next never used object in the newest slab
+    byte_t      *bump_end;
+    size_t       live;             // Objects handed out and not freed
+} pool_t;
+
+/**
+ * @brief Create a pool for objects of object_size bytes
+ * @param object_size Size of one object
+ * @param objects_per_slab Objects per slab (0 uses POOL_DEFAULT_SLAB_OBJECTS)
+ * @return Pointer to the new pool, exits on allocation failure
+ */
+pool_t *pool_init(size_t object_size, size_t objects_per_slab);
+
+/**
+ * @brief Release every slab and the pool itself, every object becomes invalid
+ * @param pool Pointer to the pool (NULL is ignored)
+ */
+void pool_destroy(pool_t *pool);
+
+/**
+ * @brief Get one uninitialized object. O(1)
+ * @param pool Pointer to the pool
+ * @return Pointer to the object, exits on allocation failure
+ */
+void *pool_alloc(pool_t *pool);
+
+/**
+ * @brief Give an object back to the pool for reuse. O(1)
+ * @param pool Pointer to the pool the object came from
+ * @param object Object to release (NULL is ignored)
+ */
+void pool_free(pool_t *pool, void *object);
+
+/**
+ * @brief Number of objects currently handed out
+ * @param pool Pointer to the pool
+ * @return Live objects
+ */
+size_t pool_live(const pool_t *pool);
+
+#endif // C_WORL_POOL_H
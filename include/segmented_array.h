@@ -0,0 +1,102 @@
+/**
+ * @file segmented_array.h
+ * @brief Growable array made of fixed power-of-two chunks
+ *
+ * Elements live in chunks of SEGARRAY_CHUNK_SIZE slots reached through a small directory of
+ * chunk pointers. Growing allocates one more chunk and never moves existing elements, so the
+ * address of a slot stays valid until that element is popped, and peak memory during growth
+ * is the live data plus one chunk (the directory is 1 / SEGARRAY_CHUNK_SIZE of the data).
+ * Time: O(1) append (no copy), O(1) access with a shift and a mask
+ * Space: O(n)
+ */
+
+#ifndef C_WORL_SEGMENTED_ARRAY_H
+#define C_WORL_SEGMENTED_ARRAY_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// log2 of the slots per chunk, override with -DSEGARRAY_CHUNK_BITS=<n>
+#ifndef SEGARRAY_CHUNK_BITS
+#define SEGARRAY_CHUNK_BITS 12
+#endif
+#define SEGARRAY_CHUNK_SIZE ((size_t) 1 << SEGARRAY_CHUNK_BITS)
+#define SEGARRAY_CHUNK_MASK (SEGARRAY_CHUNK_SIZE - 1)
+
+#define SEGARRAY_INITIAL_DIRECTORY 8
+
+typedef struct segmented_array_t
+{
+    void ***chunks;        // Directory of chunk pointers, each chunk holds SEGARRAY_CHUNK_SIZE
+    size_t  chunk_count;   // Chunks allocated
+    size_t  dir_capacity;  // Slots in the directory
+    size_t  size;
+} segmented_array_t;
+
+/**
+ * @brief Initialize a new segmented array, no chunk is allocated until the first push
+ * @return Pointer to the new array, exits on allocation failure
+ */
+segmented_array_t *segarray_init(void);
+
+/**
+ * @brief Free all chunks and the array itself (elements are not freed)
+ * @param arr Pointer to array structure
+ */
+void segarray_destroy(segmented_array_t *arr);
+
+/**
+ * @brief Append an element to the end, existing elements never move. O(1)
+ * @param arr Pointer to array structure
+ * @param element Element to append
+ * @return true on success, false on allocation failure
+ */
+bool segarray_push(segmented_array_t *arr, void *element);
+
+/**
+ * @brief Remove and return the last element. O(1)
+ * @param arr Pointer to array structure
+ * @return Last element, or NULL if empty
+ */
+void *segarray_pop(segmented_array_t *arr);
+
+/**
+ * @brief Get element at index. O(1)
+ * @param arr Pointer to array structure
+ * @param index Index to access
+ * @return Element at index, or NULL if out of bounds
+ */
+void *segarray_get(const segmented_array_t *arr, size_t index);
+
+/**
+ * @brief Overwrite the element at index. O(1)
+ * @param arr Pointer to array structure
+ * @param index Index to set
+ * @param element Element to store
+ * @return true on success, false if out of bounds
+ */
+bool segarray_set(segmented_array_t *arr, size_t index, void *element);
+
+/**
+ * @brief Stable address of the slot at index, valid until the element is popped
+ * @param arr Pointer to array structure
+ * @param index Index to access
+ * @return Pointer to the slot, or NULL if out of bounds
+ */
+void **segarray_slot(const segmented_array_t *arr, size_t index);
+
+/**
+ * @brief Get current size
+ * @param arr Pointer to array structure
+ * @return Number of elements
+ */
+size_t segarray_size(const segmented_array_t *arr);
+
+/**
+ * @brief Check if array is empty
+ * @param arr Pointer to array structure
+ * @return true if empty
+ */
+bool segarray_is_empty(const segmented_array_t *arr);
+
+#endif // C_WORL_SEGMENTED_ARRAY_H
@@ -0,0 +1,65 @@
+/**
+ * @file skip_list.h
+ * @brief Indexable skip list: a positional sequence with O(log n) access by index
+ *
+ * Every forward link stores its span (how many positions it jumps), so a search adds up spans
+ * while descending levels and reaches any index in O(log n) expected steps. Operations and
+ * value ownership mirror linked_list.h: skiplist_remove_node and skiplist_delete free the
+ * values, pops hand them back to the caller, out of range indexes call throw_error.
+ * Time: O(log n) expected insert, remove and get at any index
+ * Space: O(n) expected (1 / (1 - SKIPLIST_P) links per node on average)
+ */
+
+#ifndef C_WORL_SKIP_LIST_H
+#define C_WORL_SKIP_LIST_H
+
+#include "utils.h"
+
+#include <stddef.h>
+
+#define SKIPLIST_MAX_LEVEL 32
+// A node reaches level i + 1 with probability 1 / SKIPLIST_P_INVERSE
+#define SKIPLIST_P_INVERSE 4
+
+struct skip_node_t;
+
+typedef struct skip_link_t
+{
+    struct skip_node_t *next;
+    size_t              span; // Positions between this node and next (or the end past the tail)
+} skip_link_t;
+
+typedef struct skip_node_t
+{
+    void       *value;
+    size_t      level;
+    skip_link_t links[]; // level links, level 0 is the plain list
+} skip_node_t;
+
+typedef struct skip_list_t
+{
+    skip_node_t *head;  // Sentinel at position 0 with SKIPLIST_MAX_LEVEL links
+    size_t       len;
+    size_t       level; // Levels in use
+    u64_t        rng;   // xorshift state for the level coin flips
+} skip_list_t;
+
+skip_list_t *skiplist_init(void);
+
+void skiplist_delete(skip_list_t *list);
+
+void skiplist_push_node(skip_list_t *list, void *data);
+
+void *skiplist_pop_head(skip_list_t *list);
+
+void *skiplist_pop_tail(skip_list_t *list);
+
+void skiplist_insert_node(skip_list_t *list, size_t index, void *data);
+
+void skiplist_remove_node(skip_list_t *list, size_t index);
+
+size_t skiplist_size(const skip_list_t *list);
+
+void *skiplist_get_element(const skip_list_t *list, size_t index);
+
+#endif // C_WORL_SKIP_LIST_H
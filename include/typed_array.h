@@ -0,0 +1,159 @@
+/**
+ * @file typed_array.h
+ * @brief Type specialized dynamic arrays that store values inline
+ *
+ * DYNARRAY_DEFINE(name, T) generates a `name_t` array holding T values contiguously plus
+ * static inline functions mirroring dynamic_array.h:
+ *
+ *     name_t *name_init(void)                         O(1)
+ *     void    name_destroy(name_t *arr)               O(1)
+ *     bool    name_push(name_t *arr, T value)         O(1) amortized
+ *     bool    name_pop(name_t *arr, T *out)           O(1), false if empty
+ *     T      *name_get(const name_t *arr, size_t i)   O(1), NULL if out of bounds
+ *     bool    name_set(name_t *arr, size_t i, T v)    O(1), overwrites, false if out of bounds
+ *     bool    name_insert(name_t *arr, size_t i, T v) O(n), i == size appends
+ *     bool    name_erase(name_t *arr, size_t i)       O(n), false if out of bounds
+ *     size_t  name_size(const name_t *arr)            O(1)
+ *     bool    name_is_empty(const name_t *arr)        O(1)
+ *
+ * Unlike dynamic_array_t there is no pointer per element, so a scan walks one flat buffer.
+ * Pointers returned by name_get are invalidated by any call that grows the array.
+ */
+
+#ifndef C_WORL_TYPED_ARRAY_H
+#define C_WORL_TYPED_ARRAY_H
+
+#include "dynamic_array.h"
+#include "utils.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define DYNARRAY_DEFINE(name, T)                                                                   \
+    typedef struct name##_t                                                                        \
+    {                                                                                              \
+        T     *data;                                                                               \
+        size_t size;                                                                               \
+        size_t capacity;                                                                           \
+    } name##_t;                                                                                    \
+                                                                                                   \
+    static inline name##_t *name##_init(void)                                                      \
+    {                                                                                              \
+        name##_t *arr = malloc(sizeof(name##_t));                                                  \
+        check_mem_alloc(arr, "Typed array init");                                                  \
+        arr->data = malloc(DYNARRAY_INITIAL_CAPACITY * sizeof(T));                                 \
+        check_mem_alloc(arr->data, "Typed array data");                                            \
+        arr->size     = ZERO;                                                                      \
+        arr->capacity = DYNARRAY_INITIAL_CAPACITY;                                                 \
+        return arr;                                                                                \
+    }                                                                                              \
+                                                                                                   \
+    static inline void name##_destroy(name##_t *arr)                                               \
+    {                                                                                              \
+        free(arr->data);                                                                           \
+        free(arr);                                                                                 \
+    }                                                                                              \
+                                                                                                   \
+    static inline bool name##_grow(name##_t *arr)                                                  \
+    {                                                                                              \
+        if (arr->capacity > SIZE_MAX / sizeof(T) / DYNARRAY_GROWTH_FACTOR)                         \
+        {                                                                                          \
+            return FALSE;                                                                          \
+        }                                                                                          \
+        size_t new_capacity = arr->capacity * DYNARRAY_GROWTH_FACTOR;                              \
+        T     *new_data     = realloc(arr->data, new_capacity * sizeof(T));                        \
+        if (new_data == NULL)                                                                      \
+        {                                                                                          \
+            return FALSE;                                                                          \
+        }                                                                                          \
+        arr->data     = new_data;                                                                  \
+        arr->capacity = new_capacity;                                                              \
+        return TRUE;                                                                               \
+    }                                                                                              \
+                                                                                                   \
+    static inline bool name##_push(name##_t *arr, T value)                                         \
+    {                                                                                              \
+        if (arr->size == arr->capacity && name##_grow(arr) == FALSE)                               \
+        {                                                                                          \
+            return FALSE;                                                                          \
+        }                                                                                          \
+        arr->data[arr->size++] = value;                                                            \
+        return TRUE;                                                                               \
+    }                                                                                              \
+                                                                                                   \
+    static inline bool name##_pop(name##_t *arr, T *out)                                           \
+    {                                                                                              \
+        if (arr->size == ZERO)                                                                     \
+        {                                                                                          \
+            return FALSE;                                                                          \
+        }                                                                                          \
+        arr->size--;                                                                               \
+        if (out != NULL)                                                                           \
+        {                                                                                          \
+            *out = arr->data[arr->size];                                                           \
+        }                                                                                          \
+        return TRUE;                                                                               \
+    }                                                                                              \
+                                                                                                   \
+    static inline T *name##_get(const name##_t *arr, size_t index)                                 \
+    {                                                                                              \
+        if (index >= arr->size)                                                                    \
+        {                                                                                          \
+            return NULL;                                                                           \
+        }                                                                                          \
+        return &arr->data[index];                                                                  \
+    }                                                                                              \
+                                                                                                   \
+    static inline bool name##_set(name##_t *arr, size_t index, T value)                            \
+    {                                                                                              \
+        if (index >= arr->size)                                                                    \
+        {                                                                                          \
+            return FALSE;                                                                          \
+        }                                                                                          \
+        arr->data[index] = value;                                                                  \
+        return TRUE;                                                                               \
+    }                                                                                              \
+                                                                                                   \
+    static inline bool name##_insert(name##_t *arr, size_t index, T value)                         \
+    {                                                                                              \
+        if (index > arr->size)                                                                     \
+        {                                                                                          \
+            return FALSE;                                                                          \
+        }                                                                                          \
+        if (arr->size == arr->capacity && name##_grow(arr) == FALSE)                               \
+        {                                                                                          \
+            return FALSE;                                                                          \
+        }                                                                                          \
+        memmove(&arr->data[index + ONE], &arr->data[index], (arr->size - index) * sizeof(T));     \
+        arr->data[index] = value;                                                                  \
+        arr->size++;                                                                               \
+        return TRUE;                                                                               \
+    }                                                                                              \
+                                                                                                   \
+    static inline bool name##_erase(name##_t *arr, size_t index)                                   \
+    {                                                                                              \
+        if (index >= arr->size)                                                                    \
+        {                                                                                          \
+            return FALSE;                                                                          \
+        }                                                                                          \
+        memmove(&arr->data[index],                                                                 \
+                &arr->data[index + ONE],                                                           \
+                (arr->size - index - ONE) * sizeof(T));                                            \
+        arr->size--;                                                                               \
+        return TRUE;                                                                               \
+    }                                                                                              \
+                                                                                                   \
+    static inline size_t name##_size(const name##_t *arr)                                          \
+    {                                                                                              \
+        return arr->size;                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    static inline bool name##_is_empty(const name##_t *arr)                                        \
+    {                                                                                              \
+        return arr->size == ZERO;                                                                  \
+    }
+
+#endif // C_WORL_TYPED_ARRAY_H
@@ -0,0 +1,57 @@
+/**
+ * @file unrolled_list.h
+ * @brief Doubly linked list that stores up to ULIST_NODE_CAPACITY values per node
+ *
+ * Same operations and ownership rules as linked_list.h (the list frees values in
+ * ulist_remove_node and ulist_delete), but each node packs a small array of values sized to
+ * two cache lines, so a traversal takes one miss per ULIST_NODE_CAPACITY elements and an
+ * indexed walk skips whole nodes. Full nodes split in half on insert, nodes under half full
+ * merge with their successor on remove.
+ * Time: O(n / B) insert, remove and get (walking from the nearer end), O(1) push and pop
+ * Space: O(n)
+ */
+
+#ifndef C_WORL_UNROLLED_LIST_H
+#define C_WORL_UNROLLED_LIST_H
+
+#include "utils.h"
+
+#include <stddef.h>
+
+// 3 header words + 13 values = 128 bytes per node on 64-bit targets
+#define ULIST_NODE_CAPACITY 13
+
+typedef struct unode_t
+{
+    struct unode_t *prev;
+    struct unode_t *next;
+    size_t          count;
+    void           *values[ULIST_NODE_CAPACITY];
+} unode_t;
+
+typedef struct unrolled_list_t
+{
+    unode_t *head;
+    unode_t *tail;
+    size_t   len;
+} unrolled_list_t;
+
+unrolled_list_t *ulist_init(void);
+
+void ulist_delete(unrolled_list_t *list);
+
+void ulist_push_node(unrolled_list_t *list, void *data);
+
+void *ulist_pop_head(unrolled_list_t *list);
+
+void *ulist_pop_tail(unrolled_list_t *list);
+
+void ulist_insert_node(unrolled_list_t *list, size_t index, void *data);
+
+void ulist_remove_node(unrolled_list_t *list, size_t index);
+
+size_t ulist_size(const unrolled_list_t *list);
+
+void *ulist_get_element(const unrolled_list_t *list, size_t index);
+
+#endif // C_WORL_UNROLLED_LIST_H
@@ -0,0 +1,262 @@
+/**
+ * @file compact_list.c
+ * @brief Index linked list in a struct-of-arrays arena
+ */
+
+#include "compact_list.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+static void *clist_resize_array(void *array, size_t count, size_t element_size)
+{
+    void *resized = realloc(array, count * element_size);
+    check_mem_alloc(resized, "Compact list arena");
+    return resized;
+}
+
+static void clist_grow(compact_list_t *list)
+{
+    if (list->capacity > CLIST_MAX_CAPACITY / CLIST_GROWTH_FACTOR)
+    {
+        if (list->capacity == CLIST_MAX_CAPACITY)
+        {
+            throw_error("Compact list is full");
+        }
+        list->capacity = CLIST_MAX_CAPACITY;
+    }
+    else
+    {
+        list->capacity *= CLIST_GROWTH_FACTOR;
+    }
+    list->values = clist_resize_array((void *) list->values, list->capacity, sizeof(void *));
+    list->prev   = clist_resize_array(list->prev, list->capacity, sizeof(u32_t));
+    list->next   = clist_resize_array(list->next, list->capacity, sizeof(u32_t));
+}
+
+/*
+ * @brief Take a slot from the free-index list, or the next untouched one. O(1) amortized
+ */
+static u32_t clist_alloc_slot(compact_list_t *list, void *data)
+{
+    u32_t slot = list->free_head;
+    if (slot != CLIST_NIL)
+    {
+        list->free_head = list->next[slot];
+    }
+    else
+    {
+        if (list->used == list->capacity)
+        {
+            clist_grow(list);
+        }
+        slot = list->used++;
+    }
+    list->values[slot] = data;
+    return slot;
+}
+
+static void clist_release_slot(compact_list_t *list, u32_t slot)
+{
+    list->next[slot] = list->free_head;
+    list->free_head  = slot;
+}
+
+/*
+ * @brief Slot of element index (< len), walking from the nearer end. O(min(i, n - i))
+ */
+static u32_t clist_slot_at(const compact_list_t *list, size_t index)
+{
+    u32_t slot = CLIST_NIL;
+    if (index < list->len / 2)
+    {
+        slot = list->head;
+        for (size_t i = 0; i < index; i++)
+        {
+            slot = list->next[slot];
+        }
+        return slot;
+    }
+    slot = list->tail;
+    for (size_t i = list->len - ONE; i > index; i--)
+    {
+        slot = list->prev[slot];
+    }
+    return slot;
+}
+
+/*
+ * @brief Link slot before at, or at the tail when at is CLIST_NIL. O(1)
+ */
+static void clist_link_before(compact_list_t *list, u32_t at, u32_t slot)
+{
+    u32_t prev       = at != CLIST_NIL ? list->prev[at] : list->tail;
+    list->prev[slot] = prev;
+    list->next[slot] = at;
+    if (prev != CLIST_NIL)
+    {
+        list->next[prev] = slot;
+    }
+    else
+    {
+        list->head = slot;
+    }
+    if (at != CLIST_NIL)
+    {
+        list->prev[at] = slot;
+    }
+    else
+    {
+        list->tail = slot;
+    }
+    list->len++;
+}
+
+/*
+ * @brief Unlink slot, release it and return its value. O(1)
+ */
+static void *clist_unlink(compact_list_t *list, u32_t slot)
+{
+    u32_t prev = list->prev[slot];
+    u32_t next = list->next[slot];
+    if (prev != CLIST_NIL)
+    {
+        list->next[prev] = next;
+    }
+    else
+    {
+        list->head = next;
+    }
+    if (next != CLIST_NIL)
+    {
+        list->prev[next] = prev;
+    }
+    else
+    {
+        list->tail = prev;
+    }
+    list->len--;
+    clist_release_slot(list, slot);
+    return list->values[slot];
+}
+
+compact_list_t *clist_init(void)
+{
+    compact_list_t *list = malloc(sizeof(compact_list_t));
+    check_mem_alloc(list, "Compact list init");
+    list->capacity  = CLIST_INITIAL_CAPACITY;
+    list->values    = clist_resize_array(NULL, list->capacity, sizeof(void *));
+    list->prev      = clist_resize_array(NULL, list->capacity, sizeof(u32_t));
+    list->next      = clist_resize_array(NULL, list->capacity, sizeof(u32_t));
+    list->head      = CLIST_NIL;
+    list->tail      = CLIST_NIL;
+    list->free_head = CLIST_NIL;
+    list->used      = ZERO;
+    list->len       = ZERO;
+    return list;
+}
+
+void clist_delete_shallow(compact_list_t *list)
+{
+    if (list == NULL)
+    {
+        return;
+    }
+    free((void *) list->values);
+    free(list->prev);
+    free(list->next);
+    free(list);
+}
+
+void clist_delete(compact_list_t *list)
+{
+    if (list == NULL)
+    {
+        return;
+    }
+    for (u32_t slot = list->head; slot != CLIST_NIL; slot = list->next[slot])
+    {
+        free(list->values[slot]);
+    }
+    clist_delete_shallow(list);
+}
+
+compact_list_t *clist_clone(const compact_list_t *list)
+{
+    compact_list_t *clone = malloc(sizeof(compact_list_t));
+    check_mem_alloc(clone, "Compact list clone");
+    *clone        = *list;
+    clone->values = clist_resize_array(NULL, list->capacity, sizeof(void *));
+    clone->prev   = clist_resize_array(NULL, list->capacity, sizeof(u32_t));
+    clone->next   = clist_resize_array(NULL, list->capacity, sizeof(u32_t));
+
+    // Only [0, used) was ever written
+    memcpy((void *) clone->values, (const void *) list->values, list->used * sizeof(void *));
+    memcpy(clone->prev, list->prev, list->used * sizeof(u32_t));
+    memcpy(clone->next, list->next, list->used * sizeof(u32_t));
+    return clone;
+}
+
+void clist_push_node(compact_list_t *list, void *data)
+{
+    clist_link_before(list, CLIST_NIL, clist_alloc_slot(list, data));
+}
+
+void *clist_pop_head(compact_list_t *list)
+{
+    if (list->len == (size_t) ZERO)
+    {
+        throw_error("No elements in compact list");
+    }
+    return clist_unlink(list, list->head);
+}
+
+void *clist_pop_tail(compact_list_t *list)
+{
+    if (list->len == (size_t) ZERO)
+    {
+        throw_error("No elements in compact list");
+    }
+    return clist_unlink(list, list->tail);
+}
+
+void clist_insert_node(compact_list_t *list, size_t index, void *data)
+{
+    if (index > list->len)
+    {
+        throw_error("Too much index size for the compact list");
+    }
+    u32_t at = index == list->len ? CLIST_NIL : clist_slot_at(list, index);
+    clist_link_before(list, at, clist_alloc_slot(list, data));
+}
+
+void clist_remove_node(compact_list_t *list, size_t index)
+{
+    if (list->len == 0)
+    {
+        throw_error("EMPTY COMPACT LIST");
+    }
+    if (index > list->len - (size_t) ONE)
+    {
+        throw_error("INDEX OUT OF BOUNDARIES");
+    }
+    free(clist_unlink(list, clist_slot_at(list, index)));
+}
+
+size_t clist_size(const compact_list_t *list)
+{
+    return list->len;
+}
+
+void *clist_get_element(const compact_list_t *list, size_t index)
+{
+    if (list->len == 0)
+    {
+        throw_error("empty compact list");
+    }
+    if (index > list->len - 1)
+    {
+        throw_error("No index in compact list");
+    }
+    return list->values[clist_slot_at(list, index)];
+}
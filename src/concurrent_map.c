@@ -0,0 +1,142 @@
+/**
+ * @file concurrent_map.c
+ * @brief Sharded hash map with one reader-writer lock per shard
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "concurrent_map.h"
+
+#include "utils.h"
+
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#define CMAP_SHARD_MUL 0x9E3779B1U // 2^32 / golden ratio, independent of the in-shard hash
+
+typedef struct cmap_shard_t
+{
+    _Alignas(CMAP_CACHE_LINE) pthread_rwlock_t lock;
+    hash_map_sc_t *map;
+} cmap_shard_t;
+
+struct concurrent_map_t
+{
+    cmap_shard_t *shards;
+    size_t        shard_count;
+    u32_t         shard_shift; // 32 - log2(shard_count)
+};
+
+/*
+ * @brief Shard of key from the top bits of a multiplicative hash, the shard's own table
+ * indexes with the low bits of a different mix so both choices stay uncorrelated
+ */
+static cmap_shard_t *cmap_shard(const concurrent_map_t *map, u32_t key)
+{
+    // Widened first, a single shard shifts by the full 32 bits
+    u64_t product = (u64_t) (key * CMAP_SHARD_MUL);
+    return &map->shards[(size_t) (product >> map->shard_shift)];
+}
+
+static void cmap_check(int status, const char *error_type)
+{
+    if (status != 0)
+    {
+        throw_error(error_type);
+    }
+}
+
+concurrent_map_t *cmap_init(size_t shard_count)
+{
+    if (shard_count == ZERO)
+    {
+        shard_count = CMAP_DEFAULT_SHARDS;
+    }
+    u32_t bits = ZERO;
+    while (((size_t) ONE << bits) < shard_count)
+    {
+        bits++;
+    }
+    if (bits > 32U)
+    {
+        throw_error(" TOO MANY SHARDS");
+    }
+
+    concurrent_map_t *map = malloc(sizeof(concurrent_map_t));
+    check_mem_alloc(map, "Concurrent map init");
+    map->shard_count = (size_t) ONE << bits;
+    map->shard_shift = 32U - bits;
+    map->shards      = aligned_alloc(CMAP_CACHE_LINE, map->shard_count * sizeof(cmap_shard_t));
+    check_mem_alloc(map->shards, "Concurrent map shards");
+
+    for (size_t i = 0; i < map->shard_count; i++)
+    {
+        cmap_check(pthread_rwlock_init(&map->shards[i].lock, NULL), " INITIALIZING SHARD LOCK");
+        map->shards[i].map = init_hash_map();
+    }
+    return map;
+}
+
+void cmap_destroy(concurrent_map_t *map)
+{
+    if (map == NULL)
+    {
+        return;
+    }
+    for (size_t i = 0; i < map->shard_count; i++)
+    {
+        delete_hash_map_sc(map->shards[i].map);
+        pthread_rwlock_destroy(&map->shards[i].lock);
+    }
+    free(map->shards);
+    free(map);
+}
+
+void cmap_put(concurrent_map_t *map, u32_t key, void *data)
+{
+    cmap_shard_t *shard = cmap_shard(map, key);
+    cmap_check(pthread_rwlock_wrlock(&shard->lock), " LOCKING SHARD");
+    add_entry_sc(shard->map, key, data);
+    pthread_rwlock_unlock(&shard->lock);
+}
+
+bool cmap_get(concurrent_map_t *map, u32_t key, hash_map_visit_t reader, void *ctx)
+{
+    cmap_shard_t *shard = cmap_shard(map, key);
+    // get_entry_sc never migrates buckets, so concurrent readers leave the shard untouched
+    cmap_check(pthread_rwlock_rdlock(&shard->lock), " LOCKING SHARD");
+    void *data = get_entry_sc(shard->map, key);
+    if (data != NULL && reader != NULL)
+    {
+        reader(key, data, ctx);
+    }
+    pthread_rwlock_unlock(&shard->lock);
+    return data != NULL;
+}
+
+bool cmap_remove(concurrent_map_t *map, u32_t key)
+{
+    cmap_shard_t *shard = cmap_shard(map, key);
+    cmap_check(pthread_rwlock_wrlock(&shard->lock), " LOCKING SHARD");
+    bool removed = remove_entry_sc(shard->map, key);
+    pthread_rwlock_unlock(&shard->lock);
+    return removed;
+}
+
+size_t cmap_size(concurrent_map_t *map)
+{
+    size_t size = ZERO;
+    for (size_t i = 0; i < map->shard_count; i++)
+    {
+        cmap_check(pthread_rwlock_rdlock(&map->shards[i].lock), " LOCKING SHARD");
+        size += map->shards[i].map->size;
+        pthread_rwlock_unlock(&map->shards[i].lock);
+    }
+    return size;
+}
+
+size_t cmap_shard_count(const concurrent_map_t *map)
+{
+    return map->shard_count;
+}
@@ -0,0 +1,148 @@
+/**
+ * @file deque.c
+ * @brief Ring buffer deque
+ */
+
+#include "deque.h"
+
+#include "utils.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static size_t deque_physical(const deque_t *deque, size_t index)
+{
+    return (deque->head + index) & (deque->capacity - ONE);
+}
+
+/*
+ * @brief Move the elements into a buffer DEQUE_GROWTH_FACTOR times bigger, unwrapped so the
+ * front lands at slot 0. O(n)
+ */
+static bool deque_grow(deque_t *deque)
+{
+    if (deque->capacity > SIZE_MAX / sizeof(void *) / DEQUE_GROWTH_FACTOR)
+    {
+        return FALSE;
+    }
+    size_t new_capacity = deque->capacity * DEQUE_GROWTH_FACTOR;
+    void **new_data     = (void **) malloc(new_capacity * sizeof(void *));
+    if (new_data == NULL)
+    {
+        fprintf(stderr, "ERROR REALOCATING DEQUE\n");
+        return FALSE;
+    }
+
+    // The live range is [head, capacity) followed by [0, wrapped)
+    size_t first_part = deque->capacity - deque->head;
+    if (first_part > deque->size)
+    {
+        first_part = deque->size;
+    }
+    memcpy((void *) new_data,
+           (const void *) &deque->data[deque->head],
+           first_part * sizeof(void *));
+    memcpy((void *) &new_data[first_part],
+           (const void *) deque->data,
+           (deque->size - first_part) * sizeof(void *));
+
+    free((void *) deque->data);
+    deque->data     = new_data;
+    deque->head     = ZERO;
+    deque->capacity = new_capacity;
+    return TRUE;
+}
+
+deque_t *deque_init(void)
+{
+    deque_t *deque = malloc(sizeof(deque_t));
+    check_mem_alloc(deque, "Deque init");
+    deque->data = (void **) malloc(DEQUE_INITIAL_CAPACITY * sizeof(void *));
+    check_mem_alloc((void *) deque->data, "Deque data");
+    deque->head     = ZERO;
+    deque->size     = ZERO;
+    deque->capacity = DEQUE_INITIAL_CAPACITY;
+    return deque;
+}
+
+void deque_destroy(deque_t *deque)
+{
+    free((void *) deque->data);
+    free(deque);
+}
+
+bool deque_push_front(deque_t *deque, void *element)
+{
+    if (deque->size == deque->capacity && deque_grow(deque) == FALSE)
+    {
+        return FALSE;
+    }
+    deque->head              = (deque->head - ONE) & (deque->capacity - ONE);
+    deque->data[deque->head] = element;
+    deque->size++;
+    return TRUE;
+}
+
+bool deque_push_back(deque_t *deque, void *element)
+{
+    if (deque->size == deque->capacity && deque_grow(deque) == FALSE)
+    {
+        return FALSE;
+    }
+    deque->data[deque_physical(deque, deque->size)] = element;
+    deque->size++;
+    return TRUE;
+}
+
+void *deque_pop_front(deque_t *deque)
+{
+    if (deque->size == ZERO)
+    {
+        return NULL;
+    }
+    void *element = deque->data[deque->head];
+    deque->head   = (deque->head + ONE) & (deque->capacity - ONE);
+    deque->size--;
+    return element;
+}
+
+void *deque_pop_back(deque_t *deque)
+{
+    if (deque->size == ZERO)
+    {
+        return NULL;
+    }
+    deque->size--;
+    return deque->data[deque_physical(deque, deque->size)];
+}
+
+void *deque_get(const deque_t *deque, size_t index)
+{
+    if (index >= deque->size)
+    {
+        return NULL;
+    }
+    return deque->data[deque_physical(deque, index)];
+}
+
+bool deque_set(deque_t *deque, size_t index, void *element)
+{
+    if (index >= deque->size)
+    {
+        return FALSE;
+    }
+    deque->data[deque_physical(deque, index)] = element;
+    return TRUE;
+}
+
+size_t deque_size(const deque_t *deque)
+{
+    return deque->size;
+}
+
+bool deque_is_empty(const deque_t *deque)
+{
+    return deque->size == ZERO;
+}
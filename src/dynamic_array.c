@@ -8,13 +8,102 @@
 
 #include "utils.h"
 
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <unistd.h>
 
+#define DYNARRAY_MAX_CAPACITY (SIZE_MAX / sizeof(void *))
+
+static bool dynarray_is_inline(const dynamic_array_t *arr)
+{
+    return arr->data == arr->inline_data;
+}
+
+/*
+ * @brief Move the elements back into the inline buffer and free the heap buffer. O(size)
+ */
+static void dynarray_to_inline(dynamic_array_t *arr)
+{
+    if (dynarray_is_inline(arr) == FALSE)
+    {
+        memcpy((void *) arr->inline_data, (const void *) arr->data, arr->size * sizeof(void *));
+        free((void *) arr->data);
+        arr->data = arr->inline_data;
+    }
+    arr->capacity = DYNARRAY_INLINE_CAPACITY;
+}
+
+/*
+ * @brief Resize the data buffer to exactly new_capacity slots, spilling out of (or back
+ * into) the inline buffer when needed. O(n)
+ */
+static bool dynarray_realloc(dynamic_array_t *arr, size_t new_capacity)
+{
+    if (new_capacity > DYNARRAY_MAX_CAPACITY)
+    {
+        fprintf(stderr, "ERROR CAPACITY OVERFLOW\n");
+        return FALSE;
+    }
+    if (new_capacity <= DYNARRAY_INLINE_CAPACITY)
+    {
+        dynarray_to_inline(arr);
+        return TRUE;
+    }
+
+    void **test_realloc = NULL;
+    if (dynarray_is_inline(arr))
+    {
+        test_realloc = (void **) malloc(new_capacity * sizeof(void *));
+    }
+    else
+    {
+        test_realloc = (void **) realloc((void *) arr->data, new_capacity * sizeof(void *));
+    }
+    if (test_realloc == NULL)
+    {
+        fprintf(stderr, "ERROR REALOCATING DATA\n");
+        return FALSE;
+    }
+    if (dynarray_is_inline(arr))
+    {
+        memcpy((void *) test_realloc, (const void *) arr->inline_data, arr->size * sizeof(void *));
+    }
+    arr->data     = test_realloc;
+    arr->capacity = new_capacity;
+    return TRUE;
+}
+
+/*
+ * @brief Grow geometrically until at least min_capacity slots fit. O(1) amortized
+ */
+static bool dynarray_grow(dynamic_array_t *arr, size_t min_capacity)
+{
+    if (min_capacity <= arr->capacity)
+    {
+        return TRUE;
+    }
+    size_t new_capacity = arr->capacity;
+    while (new_capacity < min_capacity)
+    {
+        if (new_capacity > DYNARRAY_MAX_CAPACITY / DYNARRAY_GROWTH_FACTOR)
+        {
+            new_capacity = min_capacity;
+            break;
+        }
+        new_capacity *= DYNARRAY_GROWTH_FACTOR;
+    }
+    return dynarray_realloc(arr, new_capacity);
+}
+
 dynamic_array_t *dynarray_init(void)
 {
+    return dynarray_init_with_capacity(ZERO);
+}
 
+dynamic_array_t *dynarray_init_with_capacity(size_t capacity)
+{
     dynamic_array_t *arr = malloc(sizeof(dynamic_array_t));
     if (arr == NULL)
     {
@@ -22,53 +111,44 @@ dynamic_array_t *dynarray_init(void)
         _exit(EXIT_FAILURE);
     }
 
-    arr->data = (void **) malloc(DYNARRAY_INITIAL_CAPACITY * sizeof(void *));
-
-    if (arr->data == NULL)
+    dynarray_init_inline(arr);
+    if (dynarray_reserve(arr, capacity) == FALSE)
     {
         fprintf(stderr, "ERROR CREATING SPACE FOR DATA\n");
         _exit(EXIT_FAILURE);
     }
+    return arr;
+}
 
-    arr->capacity = DYNARRAY_INITIAL_CAPACITY;
+void dynarray_init_inline(dynamic_array_t *arr)
+{
+    arr->data     = arr->inline_data;
     arr->size     = ZERO;
-    return arr;
+    arr->capacity = DYNARRAY_INLINE_CAPACITY;
+}
+
+void dynarray_release(dynamic_array_t *arr)
+{
+    if (dynarray_is_inline(arr) == FALSE)
+    {
+        free((void *) arr->data);
+    }
+    dynarray_init_inline(arr);
 }
 
 void dynarray_destroy(dynamic_array_t *arr)
 {
-    free((void *) arr->data);
+    dynarray_release(arr);
     free(arr);
 }
 
 bool dynarray_push(dynamic_array_t *arr, void *element)
 {
-
-    if (arr->size > arr->capacity)
+    // Grow by DYNARRAY_GROWTH_FACTOR when full, so n pushes copy O(n) elements in total
+    if (arr->size == arr->capacity && dynarray_grow(arr, arr->size + ONE) == FALSE)
     {
-        fprintf(stderr, "WE ARE FUCKED IF THIS HAPPENSSSS\n");
         return FALSE;
     }
-
-    // Review size of the array, compare it to the initial capacity and see if it
-    //  is on the limit, if not realloc memory
-    if (arr->size == arr->capacity) // Capacity is initial capacity or the modified
-    {
-        // REALLOCATE
-        void **test_realloc =
-            (void **) realloc(arr->data, (arr->capacity + DYNARRAY_GROWTH_FACTOR) * sizeof(void *));
-        if (test_realloc == NULL)
-        {
-            free((void *) test_realloc);
-            fprintf(stderr, "ERROR REALOCATING DATA\n");
-            return FALSE;
-        }
-        arr->data              = test_realloc;
-        arr->data[arr->size++] = element;
-        // As we make bigger the dynamic array
-        arr->capacity += DYNARRAY_GROWTH_FACTOR;
-        return TRUE;
-    }
     arr->data[arr->size++] = element;
     return TRUE;
 }
@@ -119,29 +199,18 @@ bool dynarray_set(dynamic_array_t *arr, size_t index, void *element)
 
     // Tricky element, if the size == capacity, we need to realloc before inserting
     // otherwise will be segmentation fault
-    if (arr->size == arr->capacity)
+    if (arr->size == arr->capacity && dynarray_grow(arr, arr->size + ONE) == FALSE)
     {
-        // REALLOCATE
-        void **test_realloc =
-            (void **) realloc(arr->data, (arr->capacity + DYNARRAY_GROWTH_FACTOR) * sizeof(void *));
-        if (test_realloc == NULL)
-        {
-            free(test_realloc);
-            fprintf(stderr, "ERROR REALOCATING DATA\n");
-            return FALSE;
-        }
-        arr->data = test_realloc;
+        return FALSE;
     }
 
     // Base and easy case
-    // Now Simply moves every index +1 element one more and insert the new
-    for (size_t iter = arr->size; iter > index; iter--)
-    {
-        arr->data[iter] = arr->data[iter - 1];
-    }
+    // Now moves the whole tail one slot with a single block move and insert the new
+    memmove((void *) &arr->data[index + ONE],
+            (void *) &arr->data[index],
+            (arr->size - index) * sizeof(void *));
     arr->data[index] = element;
     arr->size++;
-    // In the other hand,
 
     return TRUE;
 }
@@ -159,3 +228,86 @@ bool dynarray_is_empty(const dynamic_array_t *arr)
     }
     return FALSE;
 }
+
+size_t dynarray_capacity(const dynamic_array_t *arr)
+{
+    return arr->capacity;
+}
+
+bool dynarray_reserve(dynamic_array_t *arr, size_t capacity)
+{
+    if (capacity <= arr->capacity)
+    {
+        return TRUE;
+    }
+    return dynarray_realloc(arr, capacity);
+}
+
+bool dynarray_shrink_to_fit(dynamic_array_t *arr)
+{
+    // Arrays that fit go back to the inline buffer, so realloc(ptr, 0) never happens
+    size_t new_capacity = arr->size;
+    if (new_capacity == arr->capacity)
+    {
+        return TRUE;
+    }
+    return dynarray_realloc(arr, new_capacity);
+}
+
+bool dynarray_insert_range(dynamic_array_t *arr, size_t index, void *const *elements, size_t count)
+{
+    if (index > arr->size || count > DYNARRAY_MAX_CAPACITY - arr->size)
+    {
+        return FALSE;
+    }
+    if (count == ZERO)
+    {
+        return TRUE;
+    }
+    // Grow at most once, then open the gap with one block move
+    if (dynarray_grow(arr, arr->size + count) == FALSE)
+    {
+        return FALSE;
+    }
+    memmove((void *) &arr->data[index + count],
+            (void *) &arr->data[index],
+            (arr->size - index) * sizeof(void *));
+    memcpy((void *) &arr->data[index], (const void *) elements, count * sizeof(void *));
+    arr->size += count;
+    return TRUE;
+}
+
+bool dynarray_erase_range(dynamic_array_t *arr, size_t index, size_t count)
+{
+    if (index > arr->size || count > arr->size - index)
+    {
+        return FALSE;
+    }
+    memmove((void *) &arr->data[index],
+            (void *) &arr->data[index + count],
+            (arr->size - index - count) * sizeof(void *));
+    arr->size -= count;
+    return TRUE;
+}
+
+bool dynarray_push_n(dynamic_array_t *arr, void *const *elements, size_t count)
+{
+    return dynarray_insert_range(arr, arr->size, elements, count);
+}
+
+bool dynarray_append_array(dynamic_array_t *arr, const dynamic_array_t *other)
+{
+    // Appending an array to itself reads from the buffer being grown, snapshot the size first
+    size_t count = other->size;
+    if (arr == other)
+    {
+        if (dynarray_grow(arr, arr->size + count) == FALSE)
+        {
+            return FALSE;
+        }
+        memcpy((void *) &arr->data[arr->size], (const void *) arr->data, count * sizeof(void *));
+        arr->size += count;
+        return TRUE;
+    }
+    return dynarray_push_n(arr, other->data, count);
+}
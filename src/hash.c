@@ -0,0 +1,75 @@
+/**
+ * @file hash.c
+ * @brief FNV-1a, djb2 and MurmurHash64A over byte strings
+ */
+
+#include "hash.h"
+
+#include "utils.h"
+
+#include <string.h>
+
+#define HASH_FNV_OFFSET  0xCBF29CE484222325ULL
+#define HASH_FNV_PRIME   0x100000001B3ULL
+#define HASH_DJB2_START  5381U
+#define HASH_MURMUR_MUL  0xC6A4A7935BD1E995ULL
+#define HASH_MURMUR_SHR  47U
+#define HASH_WORD_BYTES  8U
+
+u64_t hash_fnv1a(const void *key, size_t len, u64_t seed)
+{
+    const byte_t *bytes = key;
+    u64_t         hash  = HASH_FNV_OFFSET ^ seed;
+    for (size_t i = 0; i < len; i++)
+    {
+        hash ^= bytes[i];
+        hash *= HASH_FNV_PRIME;
+    }
+    return hash;
+}
+
+u64_t hash_djb2(const void *key, size_t len, u64_t seed)
+{
+    const byte_t *bytes = key;
+    u64_t         hash  = HASH_DJB2_START ^ seed;
+    for (size_t i = 0; i < len; i++)
+    {
+        hash = ((hash << 5U) + hash) ^ bytes[i];
+    }
+    return hash;
+}
+
+u64_t hash_murmur64a(const void *key, size_t len, u64_t seed)
+{
+    const byte_t *bytes = key;
+    u64_t         hash  = seed ^ ((u64_t) len * HASH_MURMUR_MUL);
+    size_t        words = len / HASH_WORD_BYTES;
+
+    for (size_t i = 0; i < words; i++)
+    {
+        u64_t word;
+        // memcpy compiles to a single load and stays defined for unaligned keys
+        memcpy(&word, bytes + i * HASH_WORD_BYTES, sizeof(word));
+        word *= HASH_MURMUR_MUL;
+        word ^= word >> HASH_MURMUR_SHR;
+        word *= HASH_MURMUR_MUL;
+        hash ^= word;
+        hash *= HASH_MURMUR_MUL;
+    }
+
+    const byte_t *tail = bytes + words * HASH_WORD_BYTES;
+    size_t        rest = len % HASH_WORD_BYTES;
+    if (rest != ZERO)
+    {
+        for (size_t i = 0; i < rest; i++)
+        {
+            hash ^= (u64_t) tail[i] << (8U * i);
+        }
+        hash *= HASH_MURMUR_MUL;
+    }
+
+    hash ^= hash >> HASH_MURMUR_SHR;
+    hash *= HASH_MURMUR_MUL;
+    hash ^= hash >> HASH_MURMUR_SHR;
+    return hash;
+}
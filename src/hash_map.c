@@ -6,6 +6,102 @@
 
 #include "utils.h"
 
+#include <string.h>
+
+// Control bytes compared per probe step. -mavx2 (or -march=native) selects 32-wide groups
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define HASH_MAP_GROUP_WIDTH 32U
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define HASH_MAP_GROUP_WIDTH 16U
+#else
+#define HASH_MAP_GROUP_WIDTH 16U
+#endif
+
+// Read prefetch kept in every cache level, the line is used within the same batch
+#define HASH_MAP_PREFETCH(address) __builtin_prefetch((address), 0, 3)
+
+#define HASH_MAP_CTRL_EMPTY   0x80U // Every special state has the high bit set, full tags do not
+#define HASH_MAP_CTRL_DELETED 0xFEU
+#define HASH_MAP_TAG_BITS     7U
+#define HASH_MAP_TAG_MASK     0x7FU
+#define HASH_MAP_SIMD_INITIAL_CAPACITY                                                             \
+    (HASH_MAP_INITIAL_CAPACITY > HASH_MAP_GROUP_WIDTH ? HASH_MAP_INITIAL_CAPACITY                  \
+                                                      : HASH_MAP_GROUP_WIDTH)
+
+#ifdef HASH_MAP_STATS
+#include <stdatomic.h>
+#include <time.h>
+
+#define HASH_MAP_NS_PER_SEC 1000000000ULL
+
+/*
+ * @brief Relaxed atomic loads and stores rather than read-modify-write: no locked instruction
+ * on the lookup path and no data race when readers share a map (concurrent_map shards), at the
+ * price of a lost count now and then under contention
+ */
+struct hash_map_counters_t
+{
+    _Atomic(u64_t) lookups;
+    _Atomic(u64_t) probes;
+    _Atomic(u64_t) probe_histogram[HASH_MAP_STATS_BINS];
+    _Atomic(u64_t) resizes;
+    _Atomic(u64_t) rehash_ns;
+};
+
+static hash_map_counters_t *stats_counters_new(void)
+{
+    hash_map_counters_t *counters = calloc(1, sizeof(hash_map_counters_t));
+    check_mem_alloc(counters, "Hash map stats");
+    return counters;
+}
+
+static void stats_add(_Atomic(u64_t) *counter, u64_t amount)
+{
+    u64_t value = atomic_load_explicit(counter, memory_order_relaxed);
+    atomic_store_explicit(counter, value + amount, memory_order_relaxed);
+}
+
+static void stats_probe(hash_map_counters_t *counters, size_t probes)
+{
+    stats_add(&counters->lookups, ONE);
+    stats_add(&counters->probes, probes);
+    stats_add(&counters->probe_histogram[probes < HASH_MAP_STATS_BINS ? probes
+                                                                       : HASH_MAP_STATS_BINS - 1],
+              ONE);
+}
+
+static u64_t stats_now(void)
+{
+    struct timespec now;
+    timespec_get(&now, TIME_UTC);
+    return (u64_t) now.tv_sec * HASH_MAP_NS_PER_SEC + (u64_t) now.tv_nsec;
+}
+
+static void stats_rehash(hash_map_counters_t *counters, u64_t started, bool resized)
+{
+    if (resized)
+    {
+        stats_add(&counters->resizes, ONE);
+    }
+    stats_add(&counters->rehash_ns, stats_now() - started);
+}
+
+#define HASH_MAP_STATS_INIT(map)                  ((map)->counters = stats_counters_new())
+#define HASH_MAP_STATS_FREE(map)                  free((map)->counters)
+#define HASH_MAP_STATS_PROBE(map, probes)         stats_probe((map)->counters, (probes))
+#define HASH_MAP_STATS_BEGIN(started)             u64_t started = stats_now()
+#define HASH_MAP_STATS_END(map, started, resized) stats_rehash((map)->counters, started, resized)
+#else
+// Probe counts are plain locals the optimizer drops once nothing reads them
+#define HASH_MAP_STATS_INIT(map)                  ((void) 0)
+#define HASH_MAP_STATS_FREE(map)                  ((void) 0)
+#define HASH_MAP_STATS_PROBE(map, probes)         ((void) (probes))
+#define HASH_MAP_STATS_BEGIN(started)             ((void) 0)
+#define HASH_MAP_STATS_END(map, started, resized) ((void) 0)
+#endif
+
 
 entry_t *create_entry(void *data){
     entry_t *new_entry = malloc(sizeof(entry_t));
@@ -26,9 +122,45 @@ mod_ll_t *mod_init_linked_list(void){
     ll->len  = 0;
     ll->head = NULL;
     ll->tail = NULL;
+    ll->pool = NULL;
     return ll;
 }
 
+mod_ll_t *mod_init_linked_list_pooled(pool_t *pool)
+{
+    mod_ll_t *ll = mod_init_linked_list();
+    ll->pool     = pool;
+    return ll;
+}
+
+/*
+ * @brief Entry from the bucket pool when it has one, from malloc otherwise
+ */
+static entry_t *mod_new_entry(mod_ll_t *list, void *data)
+{
+    if (list->pool == NULL)
+    {
+        return create_entry(data);
+    }
+    entry_t *new_entry = pool_alloc(list->pool);
+    new_entry->prev    = NULL;
+    new_entry->next    = NULL;
+    new_entry->data    = data;
+    new_entry->key     = 0;
+    return new_entry;
+}
+
+static void mod_free_entry(mod_ll_t *list, entry_t *entry)
+{
+    free(entry->data);
+    if (list->pool == NULL)
+    {
+        free(entry);
+        return;
+    }
+    pool_free(list->pool, entry);
+}
+
 
 
 void mod_delete_linked_list(mod_ll_t *list){
@@ -47,21 +179,17 @@ void mod_delete_linked_list(mod_ll_t *list){
 
     entry_t *base = list->tail;
 
-    while (base->prev != NULL)
+    while (base != NULL)
     {
         entry_t *new_base = base->prev;
-        free(base->data);
-        free(base);
+        mod_free_entry(list, base);
         base = new_base;
     }
-
-    free(base->data);
-    free(base);
     free(list);
 }
 
 void mod_push_entry(mod_ll_t *list, void *data){
-    entry_t *new_entry = create_entry(data);
+    entry_t *new_entry = mod_new_entry(list, data);
     if (list->len == (size_t) ZERO)
     {
         list->head = new_entry;
@@ -93,8 +221,7 @@ void mod_pop_head(mod_ll_t *list){
         list->head       = new_head;
     }
     list->len--;
-    free(return_entry->data);
-    free(return_entry);
+    mod_free_entry(list, return_entry);
 }
 
 void mod_pop_tail(mod_ll_t *list){
@@ -115,8 +242,7 @@ void mod_pop_tail(mod_ll_t *list){
     }
 
     list->len--;
-    free(return_entry->data);
-    free(return_entry);
+    mod_free_entry(list, return_entry);
 }
 
 void mod_remove_entry(mod_ll_t *list, size_t index){
@@ -162,8 +288,7 @@ void mod_remove_entry(mod_ll_t *list, size_t index){
     }
     index_entry->prev->next = index_entry->next;
     index_entry->next->prev = index_entry->prev;
-    free(index_entry->data);
-    free(index_entry);
+    mod_free_entry(list, index_entry);
     list->len--;
 
 }
@@ -171,35 +296,1681 @@ void mod_remove_entry(mod_ll_t *list, size_t index){
 
 
 void *mod_get_element(mod_ll_t *list, size_t index){
+    if (index >= list->len)
+    {
+        throw_error("INDEX OUT OF BOUNDARIES");
+    }
+    return rec_mod_get_element(list->head, index);
+}
+
+void *rec_mod_get_element(entry_t *actual, size_t index){
+    // Iterative walk, a recursion per node overflows the stack on long chains
+    while (index > 0)
+    {
+        actual = actual->next;
+        index--;
+    }
+    return actual->data;
+}
 
+void mod_detach_entry(mod_ll_t *list, entry_t *entry)
+{
+    if (entry->prev == NULL)
+    {
+        list->head = entry->next;
+    }
+    else
+    {
+        entry->prev->next = entry->next;
+    }
+    if (entry->next == NULL)
+    {
+        list->tail = entry->prev;
+    }
+    else
+    {
+        entry->next->prev = entry->prev;
+    }
+    entry->prev = NULL;
+    entry->next = NULL;
+    list->len--;
+}
 
+void mod_attach_entry(mod_ll_t *list, entry_t *entry)
+{
+    entry->prev = list->tail;
+    entry->next = NULL;
+    if (list->tail == NULL)
+    {
+        list->head = entry;
+    }
+    else
+    {
+        list->tail->next = entry;
+    }
+    list->tail = entry;
+    list->len++;
 }
 
-void *rec_mod_get_element(entry_t *actual, size_t index){
+void mod_attach_head(mod_ll_t *list, entry_t *entry)
+{
+    entry->prev = NULL;
+    entry->next = list->head;
+    if (list->head == NULL)
+    {
+        list->tail = entry;
+    }
+    else
+    {
+        list->head->prev = entry;
+    }
+    list->head = entry;
+    list->len++;
+}
 
+static size_t hash_map_index(u32_t key, size_t capacity)
+{
+    return (size_t) hash_mix32(key) & (capacity - ONE);
+}
 
+static void hash_map_update_load(size_t size, size_t capacity, float *load_factor)
+{
+    *load_factor = (float) size / (float) capacity;
 }
 
+/* ================================================================================================
+ * SEPARATE CHAINING
+ * ================================================================================================
+ */
+
+/*
+ * @brief Entry of key inside one bucket array, NULL if absent. *bucket_out gets its bucket
+ */
+static entry_t *find_in_buckets_sc(mod_ll_t **buckets, size_t capacity, u32_t key,
+                                   mod_ll_t **bucket_out, size_t *probes)
+{
+    mod_ll_t *bucket = buckets[hash_map_index(key, capacity)];
+    if (bucket == NULL)
+    {
+        return NULL;
+    }
+    for (entry_t *entry = bucket->head; entry != NULL; entry = entry->next)
+    {
+        (*probes)++;
+        if (entry->key == key)
+        {
+            *bucket_out = bucket;
+            return entry;
+        }
+    }
+    return NULL;
+}
 
+/*
+ * @brief Look in the current table, then in the old one while a migration is running
+ */
+static entry_t *find_entry_sc(const hash_map_sc_t *hash_map, u32_t key, mod_ll_t **bucket_out)
+{
+    size_t   probes = ZERO;
+    entry_t *entry  = find_in_buckets_sc(hash_map->buckets, hash_map->capacity, key, bucket_out,
+                                         &probes);
+    if (entry == NULL && hash_map->old_buckets != NULL)
+    {
+        entry = find_in_buckets_sc(hash_map->old_buckets, hash_map->old_capacity, key, bucket_out,
+                                   &probes);
+    }
+    HASH_MAP_STATS_PROBE(hash_map, probes);
+    return entry;
+}
 
+static mod_ll_t *bucket_sc(mod_ll_t **buckets, pool_t *entries, size_t index)
+{
+    if (buckets[index] == NULL)
+    {
+        buckets[index] = mod_init_linked_list_pooled(entries);
+    }
+    return buckets[index];
+}
 
+/*
+ * @brief Keep the current buckets as the old table and install an empty one twice as big
+ */
+static void start_rehash_sc(hash_map_sc_t *hash_map)
+{
+    HASH_MAP_STATS_BEGIN(started);
+    size_t     new_capacity = hash_map->capacity * HASH_MAP_GROWTH_FACTOR;
+    mod_ll_t **new_buckets  = calloc(new_capacity, sizeof(mod_ll_t *));
+    check_mem_alloc((void *) new_buckets, "Hash map sc rehash");
 
-void load_value_sc(hash_map_sc_t *hash_map){
+    hash_map->old_buckets  = hash_map->buckets;
+    hash_map->old_capacity = hash_map->capacity;
+    hash_map->migrate_pos  = ZERO;
+    hash_map->buckets      = new_buckets;
+    hash_map->capacity     = new_capacity;
+    hash_map_update_load(hash_map->size, hash_map->capacity, &hash_map->load_factor);
+    HASH_MAP_STATS_END(hash_map, started, TRUE);
+}
 
+/*
+ * @brief Move up to steps old buckets into the current table, freeing the old table after
+ * the last one. Entries are relinked, not reallocated: the pool and the data stay the same
+ */
+static void migrate_buckets_sc(hash_map_sc_t *hash_map, size_t steps)
+{
+    HASH_MAP_STATS_BEGIN(started);
+    while (steps > 0 && hash_map->migrate_pos < hash_map->old_capacity)
+    {
+        mod_ll_t *bucket = hash_map->old_buckets[hash_map->migrate_pos];
+        hash_map->old_buckets[hash_map->migrate_pos++] = NULL;
+        steps--;
+        if (bucket == NULL)
+        {
+            continue;
+        }
+        while (bucket->head != NULL)
+        {
+            entry_t *entry = bucket->head;
+            mod_detach_entry(bucket, entry);
+            size_t index = hash_map_index(entry->key, hash_map->capacity);
+            mod_attach_entry(bucket_sc(hash_map->buckets, hash_map->entries, index), entry);
+        }
+        free(bucket);
+    }
+    if (hash_map->migrate_pos == hash_map->old_capacity)
+    {
+        free((void *) hash_map->old_buckets);
+        hash_map->old_buckets  = NULL;
+        hash_map->old_capacity = ZERO;
+    }
+    HASH_MAP_STATS_END(hash_map, started, FALSE);
+}
 
+void load_value_sc(hash_map_sc_t *hash_map){
+    if (hash_map->old_buckets == NULL)
+    {
+        start_rehash_sc(hash_map);
+    }
+    migrate_buckets_sc(hash_map, hash_map->old_capacity);
 }
 
 hash_map_sc_t *init_hash_map(void){
+    hash_map_sc_t *hash_map = malloc(sizeof(hash_map_sc_t));
+    check_mem_alloc(hash_map, "Hash map sc init");
+    hash_map->buckets = calloc(HASH_MAP_INITIAL_CAPACITY, sizeof(mod_ll_t *));
+    check_mem_alloc((void *) hash_map->buckets, "Hash map sc buckets");
+    hash_map->old_buckets  = NULL;
+    hash_map->entries      = pool_init(sizeof(entry_t), 0);
+    hash_map->capacity     = HASH_MAP_INITIAL_CAPACITY;
+    hash_map->old_capacity = ZERO;
+    hash_map->migrate_pos  = ZERO;
+    hash_map->size         = ZERO;
+    hash_map->load_factor  = 0.0F;
+    HASH_MAP_STATS_INIT(hash_map);
+    return hash_map;
+}
 
-
+static void delete_buckets_sc(mod_ll_t **buckets, size_t capacity)
+{
+    for (size_t i = 0; i < capacity; i++)
+    {
+        mod_delete_linked_list(buckets[i]);
+    }
+    free((void *) buckets);
 }
 
 void delete_hash_map_sc(hash_map_sc_t *hash_map){
+    if (hash_map == NULL)
+    {
+        return;
+    }
+    delete_buckets_sc(hash_map->buckets, hash_map->capacity);
+    if (hash_map->old_buckets != NULL)
+    {
+        delete_buckets_sc(hash_map->old_buckets, hash_map->old_capacity);
+    }
+    pool_destroy(hash_map->entries);
+    HASH_MAP_STATS_FREE(hash_map);
+    free(hash_map);
+}
+
+void add_entry_sc(hash_map_sc_t *hash_map, u32_t key, void *data){
+    if (hash_map->old_buckets != NULL)
+    {
+        migrate_buckets_sc(hash_map, HASH_MAP_MIGRATE_STEP);
+    }
+    mod_ll_t *bucket = NULL;
+    entry_t  *entry  = find_entry_sc(hash_map, key, &bucket);
+    if (entry != NULL)
+    {
+        free(entry->data);
+        entry->data = data;
+        return;
+    }
+    // New entries always go to the current table, the old one only drains
+    size_t index = hash_map_index(key, hash_map->capacity);
+    bucket       = bucket_sc(hash_map->buckets, hash_map->entries, index);
+    mod_push_entry(bucket, data);
+    bucket->tail->key = key;
+    hash_map->size++;
+    hash_map_update_load(hash_map->size, hash_map->capacity, &hash_map->load_factor);
+    if (hash_map->load_factor > HASH_MAP_THRESHOLD)
+    {
+        // Only reachable mid migration with a tiny step: finish it before doubling again
+        if (hash_map->old_buckets != NULL)
+        {
+            migrate_buckets_sc(hash_map, hash_map->old_capacity);
+        }
+        start_rehash_sc(hash_map);
+    }
+}
+
+void *get_entry_sc(const hash_map_sc_t *hash_map, u32_t key)
+{
+    mod_ll_t *bucket = NULL;
+    entry_t  *entry  = find_entry_sc(hash_map, key, &bucket);
+    return entry == NULL ? NULL : entry->data;
+}
 
+bool remove_entry_sc(hash_map_sc_t *hash_map, u32_t key)
+{
+    if (hash_map->old_buckets != NULL)
+    {
+        migrate_buckets_sc(hash_map, HASH_MAP_MIGRATE_STEP);
+    }
+    mod_ll_t *bucket = NULL;
+    entry_t  *entry  = find_entry_sc(hash_map, key, &bucket);
+    if (entry == NULL)
+    {
+        return FALSE;
+    }
+    mod_detach_entry(bucket, entry);
+    mod_free_entry(bucket, entry);
+    hash_map->size--;
+    hash_map_update_load(hash_map->size, hash_map->capacity, &hash_map->load_factor);
+    return TRUE;
+}
 
+static void for_each_in_buckets_sc(mod_ll_t **buckets, size_t capacity, hash_map_visit_t visit,
+                                   void *ctx)
+{
+    for (size_t i = 0; i < capacity; i++)
+    {
+        if (buckets[i] == NULL)
+        {
+            continue;
+        }
+        for (entry_t *entry = buckets[i]->head; entry != NULL; entry = entry->next)
+        {
+            visit(entry->key, entry->data, ctx);
+        }
+    }
 }
 
-void add_entry_sc(hash_map_sc_t *hash_map, void *data){
+void for_each_entry_sc(const hash_map_sc_t *hash_map, hash_map_visit_t visit, void *ctx)
+{
+    for_each_in_buckets_sc(hash_map->buckets, hash_map->capacity, visit, ctx);
+    if (hash_map->old_buckets != NULL)
+    {
+        for_each_in_buckets_sc(hash_map->old_buckets, hash_map->old_capacity, visit, ctx);
+    }
+}
 
+static size_t batch_length(size_t n, size_t first)
+{
+    return n - first < HASH_MAP_BATCH ? n - first : HASH_MAP_BATCH;
+}
 
-}
\ No newline at end of file
+/*
+ * @brief Prefetch the bucket slots of a group, then their headers, then their first entries.
+ * Each pass only reads lines the previous pass requested, so it mostly hits in cache
+ */
+static void prefetch_group_sc(const hash_map_sc_t *hash_map, const u32_t *keys, size_t count)
+{
+    mod_ll_t *const *slots[HASH_MAP_BATCH];
+    for (size_t i = 0; i < count; i++)
+    {
+        slots[i] = &hash_map->buckets[hash_map_index(keys[i], hash_map->capacity)];
+        HASH_MAP_PREFETCH(slots[i]);
+    }
+    for (size_t i = 0; i < count; i++)
+    {
+        if (*slots[i] != NULL)
+        {
+            HASH_MAP_PREFETCH(*slots[i]);
+        }
+    }
+    for (size_t i = 0; i < count; i++)
+    {
+        if (*slots[i] != NULL && (*slots[i])->head != NULL)
+        {
+            HASH_MAP_PREFETCH((*slots[i])->head);
+        }
+    }
+}
+
+void get_batch_sc(const hash_map_sc_t *hash_map, const u32_t *keys, size_t n, void **out)
+{
+    for (size_t first = 0; first < n; first += HASH_MAP_BATCH)
+    {
+        size_t count = batch_length(n, first);
+        prefetch_group_sc(hash_map, keys + first, count);
+        for (size_t i = first; i < first + count; i++)
+        {
+            out[i] = get_entry_sc(hash_map, keys[i]);
+        }
+    }
+}
+
+void add_batch_sc(hash_map_sc_t *hash_map, const u32_t *keys, void *const *data, size_t n)
+{
+    for (size_t first = 0; first < n; first += HASH_MAP_BATCH)
+    {
+        size_t count = batch_length(n, first);
+        // A rehash inside the group only makes the remaining prefetches useless, not wrong
+        prefetch_group_sc(hash_map, keys + first, count);
+        for (size_t i = first; i < first + count; i++)
+        {
+            add_entry_sc(hash_map, keys[i], data[i]);
+        }
+    }
+}
+
+/* ================================================================================================
+ * OPEN ADDRESSING (ROBIN HOOD)
+ * ================================================================================================
+ */
+
+static oa_slot_t *alloc_slots_oa(size_t capacity)
+{
+    oa_slot_t *slots = calloc(capacity, sizeof(oa_slot_t));
+    check_mem_alloc(slots, "Hash map oa slots");
+    return slots;
+}
+
+/*
+ * @brief Robin Hood insert of a key known to be absent, the table must have a free slot
+ */
+static void place_entry_oa(oa_slot_t *slots, size_t capacity, u32_t key, void *data)
+{
+    size_t    mask = capacity - ONE;
+    size_t    pos  = hash_map_index(key, capacity);
+    oa_slot_t carry = {key, ONE, data};
+
+    while (slots[pos].dist != ZERO)
+    {
+        // The resident is closer to home than the carried entry: it gives up its slot
+        if (slots[pos].dist < carry.dist)
+        {
+            oa_slot_t resident = slots[pos];
+            slots[pos]         = carry;
+            carry              = resident;
+        }
+        pos = (pos + ONE) & mask;
+        carry.dist++;
+    }
+    slots[pos] = carry;
+}
+
+/*
+ * @brief Slot index of key, capacity if absent
+ */
+static size_t find_slot_oa(const hash_map_oa_t *hash_map, u32_t key)
+{
+    size_t mask = hash_map->capacity - ONE;
+    size_t pos  = hash_map_index(key, hash_map->capacity);
+    u32_t  dist = ONE;
+
+    // Every entry past a slot poorer than the probe would have displaced it, so stop there
+    while (hash_map->slots[pos].dist >= dist)
+    {
+        if (hash_map->slots[pos].key == key)
+        {
+            HASH_MAP_STATS_PROBE(hash_map, dist);
+            return pos;
+        }
+        pos = (pos + ONE) & mask;
+        dist++;
+    }
+    HASH_MAP_STATS_PROBE(hash_map, dist);
+    return hash_map->capacity;
+}
+
+void load_value_oa(hash_map_oa_t *hash_map){
+    HASH_MAP_STATS_BEGIN(started);
+    size_t     new_capacity = hash_map->capacity * HASH_MAP_GROWTH_FACTOR;
+    oa_slot_t *new_slots    = alloc_slots_oa(new_capacity);
+
+    for (size_t i = 0; i < hash_map->capacity; i++)
+    {
+        if (hash_map->slots[i].dist != ZERO)
+        {
+            place_entry_oa(new_slots, new_capacity, hash_map->slots[i].key,
+                           hash_map->slots[i].data);
+        }
+    }
+    free(hash_map->slots);
+    hash_map->slots    = new_slots;
+    hash_map->capacity = new_capacity;
+    hash_map_update_load(hash_map->size, hash_map->capacity, &hash_map->load_factor);
+    HASH_MAP_STATS_END(hash_map, started, TRUE);
+}
+
+hash_map_oa_t *init_hash_map_oa(void){
+    hash_map_oa_t *hash_map = malloc(sizeof(hash_map_oa_t));
+    check_mem_alloc(hash_map, "Hash map oa init");
+    hash_map->slots       = alloc_slots_oa(HASH_MAP_INITIAL_CAPACITY);
+    hash_map->capacity    = HASH_MAP_INITIAL_CAPACITY;
+    hash_map->size        = ZERO;
+    hash_map->load_factor = 0.0F;
+    HASH_MAP_STATS_INIT(hash_map);
+    return hash_map;
+}
+
+void delete_hash_map_oa(hash_map_oa_t *hash_map){
+    if (hash_map == NULL)
+    {
+        return;
+    }
+    for (size_t i = 0; i < hash_map->capacity; i++)
+    {
+        if (hash_map->slots[i].dist != ZERO)
+        {
+            free(hash_map->slots[i].data);
+        }
+    }
+    free(hash_map->slots);
+    HASH_MAP_STATS_FREE(hash_map);
+    free(hash_map);
+}
+
+void add_entry_oa(hash_map_oa_t *hash_map, u32_t key, void *data){
+    size_t pos = find_slot_oa(hash_map, key);
+    if (pos != hash_map->capacity)
+    {
+        free(hash_map->slots[pos].data);
+        hash_map->slots[pos].data = data;
+        return;
+    }
+    // Grow first, so the probe sequence of the new entry always ends on a free slot
+    if ((float) (hash_map->size + ONE) / (float) hash_map->capacity > HASH_MAP_THRESHOLD)
+    {
+        load_value_oa(hash_map);
+    }
+    place_entry_oa(hash_map->slots, hash_map->capacity, key, data);
+    hash_map->size++;
+    hash_map_update_load(hash_map->size, hash_map->capacity, &hash_map->load_factor);
+}
+
+void *get_entry_oa(const hash_map_oa_t *hash_map, u32_t key)
+{
+    size_t pos = find_slot_oa(hash_map, key);
+    return pos == hash_map->capacity ? NULL : hash_map->slots[pos].data;
+}
+
+bool remove_entry_oa(hash_map_oa_t *hash_map, u32_t key)
+{
+    size_t pos = find_slot_oa(hash_map, key);
+    if (pos == hash_map->capacity)
+    {
+        return FALSE;
+    }
+    free(hash_map->slots[pos].data);
+
+    // Backward shift: pull the run that follows one slot closer to home, no tombstones
+    size_t mask = hash_map->capacity - ONE;
+    size_t next = (pos + ONE) & mask;
+    while (hash_map->slots[next].dist > ONE)
+    {
+        hash_map->slots[pos] = hash_map->slots[next];
+        hash_map->slots[pos].dist--;
+        pos  = next;
+        next = (next + ONE) & mask;
+    }
+    hash_map->slots[pos].dist = ZERO;
+    hash_map->slots[pos].data = NULL;
+    hash_map->size--;
+    hash_map_update_load(hash_map->size, hash_map->capacity, &hash_map->load_factor);
+    return TRUE;
+}
+
+void for_each_entry_oa(const hash_map_oa_t *hash_map, hash_map_visit_t visit, void *ctx)
+{
+    for (size_t i = 0; i < hash_map->capacity; i++)
+    {
+        if (hash_map->slots[i].dist != ZERO)
+        {
+            visit(hash_map->slots[i].key, hash_map->slots[i].data, ctx);
+        }
+    }
+}
+
+static void prefetch_group_oa(const hash_map_oa_t *hash_map, const u32_t *keys, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        HASH_MAP_PREFETCH(&hash_map->slots[hash_map_index(keys[i], hash_map->capacity)]);
+    }
+}
+
+void get_batch_oa(const hash_map_oa_t *hash_map, const u32_t *keys, size_t n, void **out)
+{
+    for (size_t first = 0; first < n; first += HASH_MAP_BATCH)
+    {
+        size_t count = batch_length(n, first);
+        prefetch_group_oa(hash_map, keys + first, count);
+        for (size_t i = first; i < first + count; i++)
+        {
+            out[i] = get_entry_oa(hash_map, keys[i]);
+        }
+    }
+}
+
+void add_batch_oa(hash_map_oa_t *hash_map, const u32_t *keys, void *const *data, size_t n)
+{
+    for (size_t first = 0; first < n; first += HASH_MAP_BATCH)
+    {
+        size_t count = batch_length(n, first);
+        prefetch_group_oa(hash_map, keys + first, count);
+        for (size_t i = first; i < first + count; i++)
+        {
+            add_entry_oa(hash_map, keys[i], data[i]);
+        }
+    }
+}
+
+/* ================================================================================================
+ * CONTROL BYTES (SIMD GROUP PROBING)
+ * ================================================================================================
+ */
+
+/*
+ * @brief Bit i set when ctrl[i] == tag, for the HASH_MAP_GROUP_WIDTH bytes at ctrl
+ */
+static u32_t group_match(const u8_t *ctrl, u8_t tag)
+{
+#if defined(__AVX2__)
+    __m256i group = _mm256_loadu_si256((const __m256i *) (const void *) ctrl);
+    return (u32_t) _mm256_movemask_epi8(_mm256_cmpeq_epi8(group, _mm256_set1_epi8((char) tag)));
+#elif defined(__SSE2__)
+    __m128i group = _mm_loadu_si128((const __m128i *) (const void *) ctrl);
+    return (u32_t) _mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8((char) tag)));
+#else
+    u32_t mask = ZERO;
+    for (u32_t i = 0; i < HASH_MAP_GROUP_WIDTH; i++)
+    {
+        mask |= (u32_t) (ctrl[i] == tag) << i;
+    }
+    return mask;
+#endif
+}
+
+/*
+ * @brief Bit i set when ctrl[i] is empty or deleted, both have the high bit set
+ */
+static u32_t group_match_free(const u8_t *ctrl)
+{
+#if defined(__AVX2__)
+    return (u32_t) _mm256_movemask_epi8(_mm256_loadu_si256((const __m256i *) (const void *) ctrl));
+#elif defined(__SSE2__)
+    return (u32_t) _mm_movemask_epi8(_mm_loadu_si128((const __m128i *) (const void *) ctrl));
+#else
+    u32_t mask = ZERO;
+    for (u32_t i = 0; i < HASH_MAP_GROUP_WIDTH; i++)
+    {
+        mask |= (u32_t) (ctrl[i] >> HASH_MAP_TAG_BITS) << i;
+    }
+    return mask;
+#endif
+}
+
+/*
+ * @brief Write a control byte and its mirror past the end, so a group loaded near the end of
+ * the table sees the first slots without wrapping
+ */
+static void set_ctrl_simd(u8_t *ctrl, size_t capacity, size_t index, u8_t value)
+{
+    ctrl[index] = value;
+    if (index < HASH_MAP_GROUP_WIDTH)
+    {
+        ctrl[capacity + index] = value;
+    }
+}
+
+/*
+ * @brief Slot index of key, capacity if absent. Groups are visited with a triangular stride,
+ * which covers the whole power-of-two table, and the walk ends at the first group with an empty
+ * slot since an insert would have stopped there.
+ */
+static size_t find_slot_simd(const hash_map_simd_t *hash_map, u32_t key, u32_t hash)
+{
+    size_t mask   = hash_map->capacity - ONE;
+    size_t pos    = (size_t) (hash >> HASH_MAP_TAG_BITS) & mask;
+    size_t stride = ZERO;
+    u8_t   tag    = (u8_t) (hash & HASH_MAP_TAG_MASK);
+    size_t groups = ZERO;
+
+    for (;;)
+    {
+        const u8_t *group = hash_map->ctrl + pos;
+        groups++;
+        for (u32_t hits = group_match(group, tag); hits != ZERO; hits &= hits - ONE)
+        {
+            size_t index = (pos + (size_t) __builtin_ctz(hits)) & mask;
+            if (hash_map->slots[index].key == key)
+            {
+                HASH_MAP_STATS_PROBE(hash_map, groups);
+                return index;
+            }
+        }
+        if (group_match(group, (u8_t) HASH_MAP_CTRL_EMPTY) != ZERO)
+        {
+            HASH_MAP_STATS_PROBE(hash_map, groups);
+            return hash_map->capacity;
+        }
+        stride += HASH_MAP_GROUP_WIDTH;
+        pos = (pos + stride) & mask;
+    }
+}
+
+/*
+ * @brief First empty or deleted slot on the probe sequence of hash
+ */
+static size_t find_free_simd(const u8_t *ctrl, size_t capacity, u32_t hash)
+{
+    size_t mask   = capacity - ONE;
+    size_t pos    = (size_t) (hash >> HASH_MAP_TAG_BITS) & mask;
+    size_t stride = ZERO;
+    u32_t  free_slots;
+
+    while ((free_slots = group_match_free(ctrl + pos)) == ZERO)
+    {
+        stride += HASH_MAP_GROUP_WIDTH;
+        pos = (pos + stride) & mask;
+    }
+    return (pos + (size_t) __builtin_ctz(free_slots)) & mask;
+}
+
+static void alloc_table_simd(hash_map_simd_t *hash_map, size_t capacity)
+{
+    hash_map->ctrl = malloc(capacity + HASH_MAP_GROUP_WIDTH);
+    check_mem_alloc(hash_map->ctrl, "Hash map simd control bytes");
+    memset(hash_map->ctrl, HASH_MAP_CTRL_EMPTY, capacity + HASH_MAP_GROUP_WIDTH);
+    hash_map->slots = malloc(capacity * sizeof(simd_slot_t));
+    check_mem_alloc(hash_map->slots, "Hash map simd slots");
+    hash_map->capacity   = capacity;
+    hash_map->tombstones = ZERO;
+}
+
+void load_value_simd(hash_map_simd_t *hash_map){
+    HASH_MAP_STATS_BEGIN(started);
+    u8_t        *old_ctrl     = hash_map->ctrl;
+    simd_slot_t *old_slots    = hash_map->slots;
+    size_t       old_capacity = hash_map->capacity;
+
+    // Below half the threshold in live entries the load is mostly tombstones: purge in place
+    size_t new_capacity = old_capacity;
+    if ((double) (hash_map->size + ONE) > (double) old_capacity * HASH_MAP_SIMD_THRESHOLD / 2)
+    {
+        new_capacity = old_capacity * HASH_MAP_GROWTH_FACTOR;
+    }
+    alloc_table_simd(hash_map, new_capacity);
+
+    for (size_t i = 0; i < old_capacity; i++)
+    {
+        if ((old_ctrl[i] & HASH_MAP_CTRL_EMPTY) == ZERO)
+        {
+            u32_t  hash  = hash_mix32(old_slots[i].key);
+            size_t index = find_free_simd(hash_map->ctrl, new_capacity, hash);
+            set_ctrl_simd(hash_map->ctrl, new_capacity, index, old_ctrl[i]);
+            hash_map->slots[index] = old_slots[i];
+        }
+    }
+    free(old_ctrl);
+    free(old_slots);
+    hash_map_update_load(hash_map->size, hash_map->capacity, &hash_map->load_factor);
+    HASH_MAP_STATS_END(hash_map, started, TRUE);
+}
+
+hash_map_simd_t *init_hash_map_simd(void){
+    hash_map_simd_t *hash_map = malloc(sizeof(hash_map_simd_t));
+    check_mem_alloc(hash_map, "Hash map simd init");
+    alloc_table_simd(hash_map, HASH_MAP_SIMD_INITIAL_CAPACITY);
+    hash_map->size        = ZERO;
+    hash_map->load_factor = 0.0F;
+    HASH_MAP_STATS_INIT(hash_map);
+    return hash_map;
+}
+
+void delete_hash_map_simd(hash_map_simd_t *hash_map){
+    if (hash_map == NULL)
+    {
+        return;
+    }
+    for (size_t i = 0; i < hash_map->capacity; i++)
+    {
+        if ((hash_map->ctrl[i] & HASH_MAP_CTRL_EMPTY) == ZERO)
+        {
+            free(hash_map->slots[i].data);
+        }
+    }
+    free(hash_map->ctrl);
+    free(hash_map->slots);
+    HASH_MAP_STATS_FREE(hash_map);
+    free(hash_map);
+}
+
+void add_entry_simd(hash_map_simd_t *hash_map, u32_t key, void *data){
+    u32_t  hash = hash_mix32(key);
+    size_t pos  = find_slot_simd(hash_map, key, hash);
+    if (pos != hash_map->capacity)
+    {
+        free(hash_map->slots[pos].data);
+        hash_map->slots[pos].data = data;
+        return;
+    }
+    size_t used = hash_map->size + hash_map->tombstones + ONE;
+    if ((double) used > (double) hash_map->capacity * HASH_MAP_SIMD_THRESHOLD)
+    {
+        load_value_simd(hash_map);
+    }
+    pos = find_free_simd(hash_map->ctrl, hash_map->capacity, hash);
+    if (hash_map->ctrl[pos] == HASH_MAP_CTRL_DELETED)
+    {
+        hash_map->tombstones--;
+    }
+    set_ctrl_simd(hash_map->ctrl, hash_map->capacity, pos, (u8_t) (hash & HASH_MAP_TAG_MASK));
+    hash_map->slots[pos].key  = key;
+    hash_map->slots[pos].data = data;
+    hash_map->size++;
+    hash_map_update_load(hash_map->size, hash_map->capacity, &hash_map->load_factor);
+}
+
+void *get_entry_simd(const hash_map_simd_t *hash_map, u32_t key)
+{
+    size_t pos = find_slot_simd(hash_map, key, hash_mix32(key));
+    return pos == hash_map->capacity ? NULL : hash_map->slots[pos].data;
+}
+
+bool remove_entry_simd(hash_map_simd_t *hash_map, u32_t key)
+{
+    size_t pos = find_slot_simd(hash_map, key, hash_mix32(key));
+    if (pos == hash_map->capacity)
+    {
+        return FALSE;
+    }
+    free(hash_map->slots[pos].data);
+    // A tombstone keeps probe sequences that passed through this slot going
+    set_ctrl_simd(hash_map->ctrl, hash_map->capacity, pos, (u8_t) HASH_MAP_CTRL_DELETED);
+    hash_map->tombstones++;
+    hash_map->size--;
+    hash_map_update_load(hash_map->size, hash_map->capacity, &hash_map->load_factor);
+    return TRUE;
+}
+
+void for_each_entry_simd(const hash_map_simd_t *hash_map, hash_map_visit_t visit, void *ctx)
+{
+    for (size_t i = 0; i < hash_map->capacity; i++)
+    {
+        if ((hash_map->ctrl[i] & HASH_MAP_CTRL_EMPTY) == ZERO)
+        {
+            visit(hash_map->slots[i].key, hash_map->slots[i].data, ctx);
+        }
+    }
+}
+
+/* ================================================================================================
+ * FLAT CHAINING
+ * ================================================================================================
+ */
+
+/*
+ * @brief Overflow entry from the free list, or from the end of the array doubling it if full
+ */
+static u32_t fc_new_overflow(hash_map_fc_t *hash_map)
+{
+    if (hash_map->overflow_free != HASH_MAP_FC_NIL)
+    {
+        u32_t index             = hash_map->overflow_free;
+        hash_map->overflow_free = hash_map->overflow[index].next;
+        return index;
+    }
+    if (hash_map->overflow_used == hash_map->overflow_capacity)
+    {
+        size_t new_capacity = hash_map->overflow_capacity == ZERO
+                                  ? HASH_MAP_INITIAL_CAPACITY
+                                  : hash_map->overflow_capacity * HASH_MAP_GROWTH_FACTOR;
+        if (new_capacity > HASH_MAP_FC_NIL)
+        {
+            throw_error(" FLAT CHAINING OVERFLOW FULL");
+        }
+        fc_entry_t *overflow = realloc(hash_map->overflow, new_capacity * sizeof(fc_entry_t));
+        check_mem_alloc(overflow, "Hash map fc overflow");
+        hash_map->overflow          = overflow;
+        hash_map->overflow_capacity = new_capacity;
+    }
+    return (u32_t) hash_map->overflow_used++;
+}
+
+static void fc_free_overflow(hash_map_fc_t *hash_map, u32_t index)
+{
+    hash_map->overflow[index].next = hash_map->overflow_free;
+    hash_map->overflow_free        = index;
+}
+
+/*
+ * @brief Store a key known to be absent: inline if its bucket is empty, else at the head of
+ * the bucket's overflow chain
+ */
+static void fc_place(hash_map_fc_t *hash_map, u32_t key, void *data)
+{
+    fc_entry_t *bucket = &hash_map->buckets[hash_map_index(key, hash_map->capacity)];
+    if (bucket->data == NULL)
+    {
+        *bucket = (fc_entry_t) {key, HASH_MAP_FC_NIL, data};
+        return;
+    }
+    u32_t index = fc_new_overflow(hash_map);
+    // fc_new_overflow may move the overflow array, never the buckets
+    hash_map->overflow[index] = (fc_entry_t) {key, bucket->next, data};
+    bucket->next              = index;
+}
+
+static fc_entry_t *fc_find(const hash_map_fc_t *hash_map, u32_t key)
+{
+    fc_entry_t *entry = &hash_map->buckets[hash_map_index(key, hash_map->capacity)];
+    if (entry->data == NULL)
+    {
+        HASH_MAP_STATS_PROBE(hash_map, ZERO);
+        return NULL;
+    }
+    size_t probes = ONE;
+    while (entry->key != key)
+    {
+        if (entry->next == HASH_MAP_FC_NIL)
+        {
+            entry = NULL;
+            break;
+        }
+        entry = &hash_map->overflow[entry->next];
+        probes++;
+    }
+    HASH_MAP_STATS_PROBE(hash_map, probes);
+    return entry;
+}
+
+static void fc_alloc_tables(hash_map_fc_t *hash_map, size_t capacity)
+{
+    hash_map->buckets = malloc(capacity * sizeof(fc_entry_t));
+    check_mem_alloc(hash_map->buckets, "Hash map fc buckets");
+    for (size_t i = 0; i < capacity; i++)
+    {
+        hash_map->buckets[i] = (fc_entry_t) {ZERO, HASH_MAP_FC_NIL, NULL};
+    }
+    hash_map->overflow          = NULL;
+    hash_map->overflow_free     = HASH_MAP_FC_NIL;
+    hash_map->overflow_used     = ZERO;
+    hash_map->overflow_capacity = ZERO;
+    hash_map->capacity          = capacity;
+}
+
+void load_value_fc(hash_map_fc_t *hash_map){
+    HASH_MAP_STATS_BEGIN(started);
+    fc_entry_t *old_buckets  = hash_map->buckets;
+    fc_entry_t *old_overflow = hash_map->overflow;
+    size_t      old_capacity = hash_map->capacity;
+    size_t      old_used     = hash_map->overflow_used;
+
+    fc_alloc_tables(hash_map, old_capacity * HASH_MAP_GROWTH_FACTOR);
+    for (size_t i = 0; i < old_capacity; i++)
+    {
+        if (old_buckets[i].data != NULL)
+        {
+            fc_place(hash_map, old_buckets[i].key, old_buckets[i].data);
+        }
+    }
+    // Released overflow entries have their data cleared, so they are skipped like empty ones
+    for (size_t i = 0; i < old_used; i++)
+    {
+        if (old_overflow[i].data != NULL)
+        {
+            fc_place(hash_map, old_overflow[i].key, old_overflow[i].data);
+        }
+    }
+    free(old_buckets);
+    free(old_overflow);
+    hash_map_update_load(hash_map->size, hash_map->capacity, &hash_map->load_factor);
+    HASH_MAP_STATS_END(hash_map, started, TRUE);
+}
+
+hash_map_fc_t *init_hash_map_fc(void){
+    hash_map_fc_t *hash_map = malloc(sizeof(hash_map_fc_t));
+    check_mem_alloc(hash_map, "Hash map fc init");
+    fc_alloc_tables(hash_map, HASH_MAP_INITIAL_CAPACITY);
+    hash_map->size        = ZERO;
+    hash_map->load_factor = 0.0F;
+    HASH_MAP_STATS_INIT(hash_map);
+    return hash_map;
+}
+
+void delete_hash_map_fc(hash_map_fc_t *hash_map){
+    if (hash_map == NULL)
+    {
+        return;
+    }
+    for (size_t i = 0; i < hash_map->capacity; i++)
+    {
+        free(hash_map->buckets[i].data);
+    }
+    for (size_t i = 0; i < hash_map->overflow_used; i++)
+    {
+        free(hash_map->overflow[i].data);
+    }
+    free(hash_map->buckets);
+    free(hash_map->overflow);
+    HASH_MAP_STATS_FREE(hash_map);
+    free(hash_map);
+}
+
+void add_entry_fc(hash_map_fc_t *hash_map, u32_t key, void *data){
+    // NULL data marks an empty bucket, storing it would lose the entry
+    if (data == NULL)
+    {
+        throw_error(" NULL DATA IN FLAT CHAINING MAP");
+    }
+    fc_entry_t *entry = fc_find(hash_map, key);
+    if (entry != NULL)
+    {
+        free(entry->data);
+        entry->data = data;
+        return;
+    }
+    fc_place(hash_map, key, data);
+    hash_map->size++;
+    hash_map_update_load(hash_map->size, hash_map->capacity, &hash_map->load_factor);
+    if (hash_map->load_factor > HASH_MAP_THRESHOLD)
+    {
+        load_value_fc(hash_map);
+    }
+}
+
+void *get_entry_fc(const hash_map_fc_t *hash_map, u32_t key)
+{
+    fc_entry_t *entry = fc_find(hash_map, key);
+    return entry == NULL ? NULL : entry->data;
+}
+
+/*
+ * @brief Unlink the overflow entry after link (the bucket or an overflow entry) and free it
+ */
+static void fc_unlink_overflow(hash_map_fc_t *hash_map, fc_entry_t *link)
+{
+    u32_t index                    = link->next;
+    link->next                     = hash_map->overflow[index].next;
+    hash_map->overflow[index].data = NULL;
+    fc_free_overflow(hash_map, index);
+}
+
+bool remove_entry_fc(hash_map_fc_t *hash_map, u32_t key)
+{
+    fc_entry_t *bucket = &hash_map->buckets[hash_map_index(key, hash_map->capacity)];
+    if (bucket->data == NULL)
+    {
+        HASH_MAP_STATS_PROBE(hash_map, ZERO);
+        return FALSE;
+    }
+    size_t probes = ONE;
+    if (bucket->key == key)
+    {
+        free(bucket->data);
+        bucket->data = NULL;
+        // Pull the first overflow entry inline so the bucket stays the head of its chain
+        if (bucket->next != HASH_MAP_FC_NIL)
+        {
+            fc_entry_t *first = &hash_map->overflow[bucket->next];
+            bucket->key       = first->key;
+            bucket->data      = first->data;
+            fc_unlink_overflow(hash_map, bucket);
+        }
+    }
+    else
+    {
+        fc_entry_t *link = bucket;
+        while (link->next != HASH_MAP_FC_NIL && hash_map->overflow[link->next].key != key)
+        {
+            link = &hash_map->overflow[link->next];
+            probes++;
+        }
+        if (link->next == HASH_MAP_FC_NIL)
+        {
+            HASH_MAP_STATS_PROBE(hash_map, probes);
+            return FALSE;
+        }
+        probes++;
+        free(hash_map->overflow[link->next].data);
+        fc_unlink_overflow(hash_map, link);
+    }
+    HASH_MAP_STATS_PROBE(hash_map, probes);
+    hash_map->size--;
+    hash_map_update_load(hash_map->size, hash_map->capacity, &hash_map->load_factor);
+    return TRUE;
+}
+
+void for_each_entry_fc(const hash_map_fc_t *hash_map, hash_map_visit_t visit, void *ctx)
+{
+    for (size_t i = 0; i < hash_map->capacity; i++)
+    {
+        if (hash_map->buckets[i].data != NULL)
+        {
+            visit(hash_map->buckets[i].key, hash_map->buckets[i].data, ctx);
+        }
+    }
+    for (size_t i = 0; i < hash_map->overflow_used; i++)
+    {
+        if (hash_map->overflow[i].data != NULL)
+        {
+            visit(hash_map->overflow[i].key, hash_map->overflow[i].data, ctx);
+        }
+    }
+}
+
+/* ================================================================================================
+ * DENSE (INSERTION ORDERED)
+ * ================================================================================================
+ */
+
+/*
+ * @brief Largest value of an index slot, used as the empty marker. The one below marks a
+ * removed entry
+ */
+static u32_t dense_empty(const hash_map_dense_t *hash_map)
+{
+    return (u32_t) (((u64_t) ONE << (8U * hash_map->index_width)) - ONE);
+}
+
+static u32_t dense_get_index(const hash_map_dense_t *hash_map, size_t slot)
+{
+    switch (hash_map->index_width)
+    {
+    case sizeof(u8_t):
+        return ((const u8_t *) hash_map->indices)[slot];
+    case sizeof(u16_t):
+        return ((const u16_t *) hash_map->indices)[slot];
+    default:
+        return ((const u32_t *) hash_map->indices)[slot];
+    }
+}
+
+static void dense_set_index(hash_map_dense_t *hash_map, size_t slot, u32_t value)
+{
+    switch (hash_map->index_width)
+    {
+    case sizeof(u8_t):
+        ((u8_t *) hash_map->indices)[slot] = (u8_t) value;
+        break;
+    case sizeof(u16_t):
+        ((u16_t *) hash_map->indices)[slot] = (u16_t) value;
+        break;
+    default:
+        ((u32_t *) hash_map->indices)[slot] = value;
+        break;
+    }
+}
+
+/*
+ * @brief Index slot holding key, index_capacity if absent
+ */
+static size_t dense_find_slot(const hash_map_dense_t *hash_map, u32_t key)
+{
+    size_t mask    = hash_map->index_capacity - ONE;
+    size_t slot    = hash_map_index(key, hash_map->index_capacity);
+    u32_t  empty   = dense_empty(hash_map);
+    u32_t  removed = empty - ONE;
+    size_t probes  = ONE;
+    u32_t  index;
+
+    // used never passes 3/4 of the slots, so the walk always reaches an empty one
+    while ((index = dense_get_index(hash_map, slot)) != empty)
+    {
+        if (index != removed && hash_map->entries[index].key == key)
+        {
+            HASH_MAP_STATS_PROBE(hash_map, probes);
+            return slot;
+        }
+        slot = (slot + ONE) & mask;
+        probes++;
+    }
+    HASH_MAP_STATS_PROBE(hash_map, probes);
+    return hash_map->index_capacity;
+}
+
+/*
+ * @brief Point a free index slot on the probe sequence of key at entry
+ */
+static void dense_link(hash_map_dense_t *hash_map, u32_t key, size_t entry)
+{
+    size_t mask    = hash_map->index_capacity - ONE;
+    u32_t  removed = dense_empty(hash_map) - ONE;
+    size_t slot    = hash_map_index(key, hash_map->index_capacity);
+    while (dense_get_index(hash_map, slot) < removed)
+    {
+        slot = (slot + ONE) & mask;
+    }
+    dense_set_index(hash_map, slot, (u32_t) entry);
+}
+
+/*
+ * @brief Allocate an empty index table of index_capacity slots and size the entries to match
+ */
+static void dense_alloc_index(hash_map_dense_t *hash_map, size_t index_capacity)
+{
+    size_t entries_capacity = (size_t) ((double) index_capacity * HASH_MAP_THRESHOLD);
+    if (entries_capacity > UINT32_MAX - ONE)
+    {
+        throw_error(" DENSE MAP FULL");
+    }
+    // Both sentinels must stay above every entry index
+    hash_map->index_width = entries_capacity <= UINT8_MAX - ONE    ? sizeof(u8_t)
+                            : entries_capacity <= UINT16_MAX - ONE ? sizeof(u16_t)
+                                                                   : sizeof(u32_t);
+    hash_map->indices = malloc(index_capacity * hash_map->index_width);
+    check_mem_alloc(hash_map->indices, "Hash map dense indices");
+    memset(hash_map->indices, 0xFF, index_capacity * hash_map->index_width);
+    hash_map->index_capacity = index_capacity;
+
+    dense_entry_t *entries = realloc(hash_map->entries, entries_capacity * sizeof(dense_entry_t));
+    check_mem_alloc(entries, "Hash map dense entries");
+    hash_map->entries          = entries;
+    hash_map->entries_capacity = entries_capacity;
+}
+
+/*
+ * @brief Move the live entries down over the removed ones, keeping their order
+ */
+static void dense_squeeze(hash_map_dense_t *hash_map)
+{
+    size_t kept = ZERO;
+    for (size_t i = 0; i < hash_map->used; i++)
+    {
+        if (hash_map->entries[i].data != NULL)
+        {
+            hash_map->entries[kept++] = hash_map->entries[i];
+        }
+    }
+    hash_map->used = kept;
+}
+
+static void dense_reindex(hash_map_dense_t *hash_map, size_t index_capacity)
+{
+    HASH_MAP_STATS_BEGIN(started);
+    dense_squeeze(hash_map);
+    free(hash_map->indices);
+    dense_alloc_index(hash_map, index_capacity);
+    for (size_t i = 0; i < hash_map->used; i++)
+    {
+        dense_link(hash_map, hash_map->entries[i].key, i);
+    }
+    hash_map_update_load(hash_map->size, hash_map->index_capacity, &hash_map->load_factor);
+    HASH_MAP_STATS_END(hash_map, started, TRUE);
+}
+
+void load_value_dense(hash_map_dense_t *hash_map){
+    size_t index_capacity = hash_map->index_capacity;
+    // Removed entries are only reclaimed here: grow only when live ones fill half the room
+    if (hash_map->size * 2 >= hash_map->entries_capacity)
+    {
+        index_capacity *= HASH_MAP_GROWTH_FACTOR;
+    }
+    dense_reindex(hash_map, index_capacity);
+}
+
+void compact_dense(hash_map_dense_t *hash_map)
+{
+    dense_reindex(hash_map, hash_map->index_capacity);
+}
+
+hash_map_dense_t *init_hash_map_dense(void){
+    hash_map_dense_t *hash_map = malloc(sizeof(hash_map_dense_t));
+    check_mem_alloc(hash_map, "Hash map dense init");
+    hash_map->entries = NULL;
+    dense_alloc_index(hash_map, HASH_MAP_INITIAL_CAPACITY);
+    hash_map->used        = ZERO;
+    hash_map->size        = ZERO;
+    hash_map->load_factor = 0.0F;
+    HASH_MAP_STATS_INIT(hash_map);
+    return hash_map;
+}
+
+void delete_hash_map_dense(hash_map_dense_t *hash_map){
+    if (hash_map == NULL)
+    {
+        return;
+    }
+    for (size_t i = 0; i < hash_map->used; i++)
+    {
+        free(hash_map->entries[i].data);
+    }
+    free(hash_map->entries);
+    free(hash_map->indices);
+    HASH_MAP_STATS_FREE(hash_map);
+    free(hash_map);
+}
+
+void add_entry_dense(hash_map_dense_t *hash_map, u32_t key, void *data){
+    // NULL data marks a removed entry, storing it would lose the entry
+    if (data == NULL)
+    {
+        throw_error(" NULL DATA IN DENSE MAP");
+    }
+    size_t slot = dense_find_slot(hash_map, key);
+    if (slot != hash_map->index_capacity)
+    {
+        dense_entry_t *entry = &hash_map->entries[dense_get_index(hash_map, slot)];
+        free(entry->data);
+        entry->data = data;
+        return;
+    }
+    if (hash_map->used == hash_map->entries_capacity)
+    {
+        load_value_dense(hash_map);
+    }
+    hash_map->entries[hash_map->used] = (dense_entry_t) {key, data};
+    dense_link(hash_map, key, hash_map->used);
+    hash_map->used++;
+    hash_map->size++;
+    hash_map_update_load(hash_map->size, hash_map->index_capacity, &hash_map->load_factor);
+}
+
+void *get_entry_dense(const hash_map_dense_t *hash_map, u32_t key)
+{
+    size_t slot = dense_find_slot(hash_map, key);
+    if (slot == hash_map->index_capacity)
+    {
+        return NULL;
+    }
+    return hash_map->entries[dense_get_index(hash_map, slot)].data;
+}
+
+bool remove_entry_dense(hash_map_dense_t *hash_map, u32_t key)
+{
+    size_t slot = dense_find_slot(hash_map, key);
+    if (slot == hash_map->index_capacity)
+    {
+        return FALSE;
+    }
+    dense_entry_t *entry = &hash_map->entries[dense_get_index(hash_map, slot)];
+    free(entry->data);
+    entry->data = NULL;
+    dense_set_index(hash_map, slot, dense_empty(hash_map) - ONE);
+    hash_map->size--;
+    hash_map_update_load(hash_map->size, hash_map->index_capacity, &hash_map->load_factor);
+    return TRUE;
+}
+
+void for_each_entry_dense(const hash_map_dense_t *hash_map, hash_map_visit_t visit, void *ctx)
+{
+    for (size_t i = 0; i < hash_map->used; i++)
+    {
+        if (hash_map->entries[i].data != NULL)
+        {
+            visit(hash_map->entries[i].key, hash_map->entries[i].data, ctx);
+        }
+    }
+}
+
+const dense_entry_t *entries_dense(hash_map_dense_t *hash_map)
+{
+    if (hash_map->used != hash_map->size)
+    {
+        compact_dense(hash_map);
+    }
+    return hash_map->entries;
+}
+
+/* ================================================================================================
+ * BYTE KEYS
+ * ================================================================================================
+ */
+
+/*
+ * @brief Fold the high half in, FNV-1a and djb2 keep most of their entropy in the high bits
+ */
+static size_t bytes_index(u64_t hash, size_t capacity)
+{
+    return (size_t) (hash ^ (hash >> 32U)) & (capacity - ONE);
+}
+
+/*
+ * @brief Link that points to the entry of key (or the NULL ending its chain when absent)
+ */
+static bytes_entry_t **find_link_bytes(const hash_map_bytes_t *hash_map, const void *key,
+                                       size_t key_len, u64_t hash)
+{
+    bytes_entry_t **link   = &hash_map->buckets[bytes_index(hash, hash_map->capacity)];
+    size_t          probes = ZERO;
+    while (*link != NULL)
+    {
+        const bytes_entry_t *entry = *link;
+        probes++;
+        // Different hashes cannot be equal keys, the byte compare only runs on a hash match
+        if (entry->hash == hash && entry->key_len == key_len &&
+            memcmp(entry->key, key, key_len) == 0)
+        {
+            break;
+        }
+        link = &(*link)->next;
+    }
+    HASH_MAP_STATS_PROBE(hash_map, probes);
+    return link;
+}
+
+void load_value_bytes(hash_map_bytes_t *hash_map){
+    HASH_MAP_STATS_BEGIN(started);
+    size_t          new_capacity = hash_map->capacity * HASH_MAP_GROWTH_FACTOR;
+    bytes_entry_t **new_buckets  = calloc(new_capacity, sizeof(bytes_entry_t *));
+    check_mem_alloc((void *) new_buckets, "Hash map bytes rehash");
+
+    for (size_t i = 0; i < hash_map->capacity; i++)
+    {
+        bytes_entry_t *entry = hash_map->buckets[i];
+        while (entry != NULL)
+        {
+            bytes_entry_t *next  = entry->next;
+            size_t         index = bytes_index(entry->hash, new_capacity);
+            entry->next          = new_buckets[index];
+            new_buckets[index]   = entry;
+            entry                = next;
+        }
+    }
+    free((void *) hash_map->buckets);
+    hash_map->buckets  = new_buckets;
+    hash_map->capacity = new_capacity;
+    hash_map_update_load(hash_map->size, hash_map->capacity, &hash_map->load_factor);
+    HASH_MAP_STATS_END(hash_map, started, TRUE);
+}
+
+hash_map_bytes_t *init_hash_map_bytes(hash_fn_t hash, u64_t seed){
+    hash_map_bytes_t *hash_map = malloc(sizeof(hash_map_bytes_t));
+    check_mem_alloc(hash_map, "Hash map bytes init");
+    hash_map->buckets = calloc(HASH_MAP_INITIAL_CAPACITY, sizeof(bytes_entry_t *));
+    check_mem_alloc((void *) hash_map->buckets, "Hash map bytes buckets");
+    hash_map->hash        = hash == NULL ? hash_murmur64a : hash;
+    hash_map->seed        = seed;
+    hash_map->capacity    = HASH_MAP_INITIAL_CAPACITY;
+    hash_map->size        = ZERO;
+    hash_map->load_factor = 0.0F;
+    HASH_MAP_STATS_INIT(hash_map);
+    return hash_map;
+}
+
+void delete_hash_map_bytes(hash_map_bytes_t *hash_map){
+    if (hash_map == NULL)
+    {
+        return;
+    }
+    for (size_t i = 0; i < hash_map->capacity; i++)
+    {
+        bytes_entry_t *entry = hash_map->buckets[i];
+        while (entry != NULL)
+        {
+            bytes_entry_t *next = entry->next;
+            free(entry->data);
+            free(entry);
+            entry = next;
+        }
+    }
+    free((void *) hash_map->buckets);
+    HASH_MAP_STATS_FREE(hash_map);
+    free(hash_map);
+}
+
+void add_entry_bytes(hash_map_bytes_t *hash_map, const void *key, size_t key_len, void *data){
+    u64_t           hash = hash_map->hash(key, key_len, hash_map->seed);
+    bytes_entry_t **link = find_link_bytes(hash_map, key, key_len, hash);
+    if (*link != NULL)
+    {
+        free((*link)->data);
+        (*link)->data = data;
+        return;
+    }
+    bytes_entry_t *entry = malloc(sizeof(bytes_entry_t) + key_len);
+    check_mem_alloc(entry, "Hash map bytes entry");
+    entry->next    = NULL;
+    entry->hash    = hash;
+    entry->data    = data;
+    entry->key_len = key_len;
+    memcpy(entry->key, key, key_len);
+    *link = entry;
+
+    hash_map->size++;
+    hash_map_update_load(hash_map->size, hash_map->capacity, &hash_map->load_factor);
+    if (hash_map->load_factor > HASH_MAP_THRESHOLD)
+    {
+        load_value_bytes(hash_map);
+    }
+}
+
+void *get_entry_bytes(const hash_map_bytes_t *hash_map, const void *key, size_t key_len)
+{
+    u64_t          hash  = hash_map->hash(key, key_len, hash_map->seed);
+    bytes_entry_t *entry = *find_link_bytes(hash_map, key, key_len, hash);
+    return entry == NULL ? NULL : entry->data;
+}
+
+bool remove_entry_bytes(hash_map_bytes_t *hash_map, const void *key, size_t key_len)
+{
+    u64_t           hash  = hash_map->hash(key, key_len, hash_map->seed);
+    bytes_entry_t **link  = find_link_bytes(hash_map, key, key_len, hash);
+    bytes_entry_t  *entry = *link;
+    if (entry == NULL)
+    {
+        return FALSE;
+    }
+    *link = entry->next;
+    free(entry->data);
+    free(entry);
+    hash_map->size--;
+    hash_map_update_load(hash_map->size, hash_map->capacity, &hash_map->load_factor);
+    return TRUE;
+}
+
+void for_each_entry_bytes(const hash_map_bytes_t *hash_map, hash_map_bytes_visit_t visit,
+                          void *ctx)
+{
+    for (size_t i = 0; i < hash_map->capacity; i++)
+    {
+        for (bytes_entry_t *entry = hash_map->buckets[i]; entry != NULL; entry = entry->next)
+        {
+            visit(entry->key, entry->key_len, entry->data, ctx);
+        }
+    }
+}
+
+/* ================================================================================================
+ * STATISTICS
+ * ================================================================================================
+ */
+
+static void stats_begin(hash_map_stats_t *stats, size_t size, size_t capacity, float load_factor)
+{
+    memset(stats, 0, sizeof(*stats));
+    stats->size        = size;
+    stats->capacity    = capacity;
+    stats->load_factor = load_factor;
+}
+
+static void stats_length(hash_map_stats_t *stats, size_t length)
+{
+    stats->length_histogram[length < HASH_MAP_STATS_BINS ? length : HASH_MAP_STATS_BINS - 1]++;
+    if (length > stats->max_length)
+    {
+        stats->max_length = length;
+    }
+}
+
+#ifdef HASH_MAP_STATS
+static void stats_copy_counters(hash_map_counters_t *counters, hash_map_stats_t *stats)
+{
+    stats->counting  = TRUE;
+    stats->lookups   = atomic_load_explicit(&counters->lookups, memory_order_relaxed);
+    stats->probes    = atomic_load_explicit(&counters->probes, memory_order_relaxed);
+    stats->resizes   = atomic_load_explicit(&counters->resizes, memory_order_relaxed);
+    stats->rehash_ns = atomic_load_explicit(&counters->rehash_ns, memory_order_relaxed);
+    for (size_t i = 0; i < HASH_MAP_STATS_BINS; i++)
+    {
+        stats->probe_histogram[i] =
+            atomic_load_explicit(&counters->probe_histogram[i], memory_order_relaxed);
+    }
+}
+
+#define HASH_MAP_STATS_COPY(map, stats) stats_copy_counters((map)->counters, (stats))
+#else
+#define HASH_MAP_STATS_COPY(map, stats) ((void) 0)
+#endif
+
+void stats_sc(const hash_map_sc_t *hash_map, hash_map_stats_t *stats)
+{
+    stats_begin(stats, hash_map->size, hash_map->capacity, hash_map->load_factor);
+    for (size_t i = 0; i < hash_map->capacity; i++)
+    {
+        stats_length(stats, hash_map->buckets[i] == NULL ? ZERO : hash_map->buckets[i]->len);
+    }
+    if (hash_map->old_buckets != NULL)
+    {
+        // Buckets below migrate_pos are already drained, the rest still hold entries
+        for (size_t i = hash_map->migrate_pos; i < hash_map->old_capacity; i++)
+        {
+            mod_ll_t *bucket = hash_map->old_buckets[i];
+            stats_length(stats, bucket == NULL ? ZERO : bucket->len);
+        }
+    }
+    HASH_MAP_STATS_COPY(hash_map, stats);
+}
+
+void stats_oa(const hash_map_oa_t *hash_map, hash_map_stats_t *stats)
+{
+    stats_begin(stats, hash_map->size, hash_map->capacity, hash_map->load_factor);
+    for (size_t i = 0; i < hash_map->capacity; i++)
+    {
+        if (hash_map->slots[i].dist != ZERO)
+        {
+            stats_length(stats, hash_map->slots[i].dist - ONE);
+        }
+    }
+    HASH_MAP_STATS_COPY(hash_map, stats);
+}
+
+/*
+ * @brief Groups between the home group of the key in slot index and the one holding it
+ */
+static size_t group_distance_simd(const hash_map_simd_t *hash_map, size_t index)
+{
+    size_t mask     = hash_map->capacity - ONE;
+    size_t pos      = (size_t) (hash_mix32(hash_map->slots[index].key) >> HASH_MAP_TAG_BITS) & mask;
+    size_t stride   = ZERO;
+    size_t distance = ZERO;
+    while (((index - pos) & mask) >= HASH_MAP_GROUP_WIDTH)
+    {
+        stride += HASH_MAP_GROUP_WIDTH;
+        pos = (pos + stride) & mask;
+        distance++;
+    }
+    return distance;
+}
+
+void stats_simd(const hash_map_simd_t *hash_map, hash_map_stats_t *stats)
+{
+    stats_begin(stats, hash_map->size, hash_map->capacity, hash_map->load_factor);
+    for (size_t i = 0; i < hash_map->capacity; i++)
+    {
+        if ((hash_map->ctrl[i] & HASH_MAP_CTRL_EMPTY) == ZERO)
+        {
+            stats_length(stats, group_distance_simd(hash_map, i));
+        }
+    }
+    HASH_MAP_STATS_COPY(hash_map, stats);
+}
+
+void stats_fc(const hash_map_fc_t *hash_map, hash_map_stats_t *stats)
+{
+    stats_begin(stats, hash_map->size, hash_map->capacity, hash_map->load_factor);
+    for (size_t i = 0; i < hash_map->capacity; i++)
+    {
+        size_t length = ZERO;
+        if (hash_map->buckets[i].data != NULL)
+        {
+            length = ONE;
+            for (u32_t next = hash_map->buckets[i].next; next != HASH_MAP_FC_NIL; length++)
+            {
+                next = hash_map->overflow[next].next;
+            }
+        }
+        stats_length(stats, length);
+    }
+    HASH_MAP_STATS_COPY(hash_map, stats);
+}
+
+void stats_dense(const hash_map_dense_t *hash_map, hash_map_stats_t *stats)
+{
+    stats_begin(stats, hash_map->size, hash_map->index_capacity, hash_map->load_factor);
+    size_t mask    = hash_map->index_capacity - ONE;
+    u32_t  removed = dense_empty(hash_map) - ONE;
+    for (size_t slot = 0; slot < hash_map->index_capacity; slot++)
+    {
+        u32_t index = dense_get_index(hash_map, slot);
+        if (index < removed)
+        {
+            size_t home = hash_map_index(hash_map->entries[index].key, hash_map->index_capacity);
+            stats_length(stats, (slot - home) & mask);
+        }
+    }
+    HASH_MAP_STATS_COPY(hash_map, stats);
+}
+
+void stats_bytes(const hash_map_bytes_t *hash_map, hash_map_stats_t *stats)
+{
+    stats_begin(stats, hash_map->size, hash_map->capacity, hash_map->load_factor);
+    for (size_t i = 0; i < hash_map->capacity; i++)
+    {
+        size_t length = ZERO;
+        for (const bytes_entry_t *entry = hash_map->buckets[i]; entry != NULL; entry = entry->next)
+        {
+            length++;
+        }
+        stats_length(stats, length);
+    }
+    HASH_MAP_STATS_COPY(hash_map, stats);
+}
+
+void print_hash_map_stats(FILE *out, const char *name, const hash_map_stats_t *stats)
+{
+    fprintf(out, "%s: %zu entries, capacity %zu, load %.3f, longest %zu\n", name, stats->size,
+            stats->capacity, (double) stats->load_factor, stats->max_length);
+    if (stats->counting)
+    {
+        double mean = stats->lookups == ZERO ? 0.0
+                                             : (double) stats->probes / (double) stats->lookups;
+        fprintf(out, "  %llu lookups, %.3f probes each, %llu resizes in %.3f ms\n",
+                (unsigned long long) stats->lookups, mean, (unsigned long long) stats->resizes,
+                (double) stats->rehash_ns / 1e6);
+    }
+    else
+    {
+        fprintf(out, "  counters off, build with -DHASH_MAP_STATS\n");
+    }
+
+    // Rows stop after the last non empty bin of either histogram
+    size_t rows = ZERO;
+    for (size_t i = 0; i < HASH_MAP_STATS_BINS; i++)
+    {
+        if (stats->length_histogram[i] != ZERO || stats->probe_histogram[i] != ZERO)
+        {
+            rows = i + ONE;
+        }
+    }
+    fprintf(out, "  %7s %12s %12s\n", "n", "length = n", "probes = n");
+    for (size_t i = 0; i < rows; i++)
+    {
+        fprintf(out, "  %6zu%s %12zu %12llu\n", i, i == HASH_MAP_STATS_BINS - 1 ? "+" : " ",
+                stats->length_histogram[i], (unsigned long long) stats->probe_histogram[i]);
+    }
+}
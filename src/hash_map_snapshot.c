@@ -0,0 +1,321 @@
+/**
+ * @file hash_map_snapshot.c
+ * @brief Snapshot builder (stdio) and read-only loader (mmap)
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "hash_map_snapshot.h"
+
+#include "hash.h"
+#include "utils.h"
+
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define SNAPSHOT_RECORD_HEADER (2U * sizeof(u32_t))
+#define SNAPSHOT_TMP_SUFFIX    ".tmp"
+
+typedef struct snapshot_value_t
+{
+    size_t len;
+    byte_t bytes[];
+} snapshot_value_t;
+
+/*
+ * @brief State shared by the two passes over the builder entries
+ */
+typedef struct snapshot_writer_t
+{
+    snapshot_slot_t *slots;
+    size_t           mask;
+    byte_t          *heap;
+    size_t           heap_size;
+} snapshot_writer_t;
+
+static size_t snapshot_align(size_t size)
+{
+    return (size + SNAPSHOT_ALIGNMENT - ONE) & ~((size_t) SNAPSHOT_ALIGNMENT - ONE);
+}
+
+static size_t snapshot_record_size(size_t key_len, size_t value_len)
+{
+    return snapshot_align(SNAPSHOT_RECORD_HEADER + key_len + value_len);
+}
+
+snapshot_builder_t *snapshot_builder_init(void)
+{
+    snapshot_builder_t *builder = malloc(sizeof(snapshot_builder_t));
+    check_mem_alloc(builder, "Snapshot builder init");
+    builder->entries = init_hash_map_bytes(hash_murmur64a, SNAPSHOT_SEED);
+    return builder;
+}
+
+void snapshot_builder_destroy(snapshot_builder_t *builder)
+{
+    if (builder == NULL)
+    {
+        return;
+    }
+    delete_hash_map_bytes(builder->entries);
+    free(builder);
+}
+
+void snapshot_builder_add(snapshot_builder_t *builder, const void *key, size_t key_len,
+                          const void *value, size_t value_len)
+{
+    if (key_len > UINT32_MAX || value_len > UINT32_MAX)
+    {
+        throw_error(" SNAPSHOT RECORD TOO LARGE");
+    }
+    snapshot_value_t *copy = malloc(sizeof(snapshot_value_t) + value_len);
+    check_mem_alloc(copy, "Snapshot value");
+    copy->len = value_len;
+    memcpy(copy->bytes, value, value_len);
+    add_entry_bytes(builder->entries, key, key_len, copy);
+}
+
+static void snapshot_measure_visit(const void *key, size_t key_len, void *data, void *ctx)
+{
+    (void) key;
+    snapshot_writer_t *writer = ctx;
+    writer->heap_size += snapshot_record_size(key_len, ((snapshot_value_t *) data)->len);
+}
+
+/*
+ * @brief Append the record of one entry to the heap and point a free slot of its hash at it
+ */
+static void snapshot_place_visit(const void *key, size_t key_len, void *data, void *ctx)
+{
+    snapshot_writer_t *writer = ctx;
+    snapshot_value_t  *value  = data;
+    byte_t            *record = writer->heap + writer->heap_size;
+    u32_t              lens[] = {(u32_t) key_len, (u32_t) value->len};
+
+    memcpy(record, lens, sizeof(lens));
+    memcpy(record + SNAPSHOT_RECORD_HEADER, key, key_len);
+    memcpy(record + SNAPSHOT_RECORD_HEADER + key_len, value->bytes, value->len);
+
+    u64_t  hash = hash_murmur64a(key, key_len, SNAPSHOT_SEED);
+    size_t pos  = (size_t) hash & writer->mask;
+    while (writer->slots[pos].record != SNAPSHOT_EMPTY_SLOT)
+    {
+        pos = (pos + ONE) & writer->mask;
+    }
+    writer->slots[pos] = (snapshot_slot_t) {hash, (u64_t) writer->heap_size};
+    writer->heap_size += snapshot_record_size(key_len, value->len);
+}
+
+/*
+ * @brief Write to path.tmp, flush it to disk and rename it over path. Readers that still map
+ * the old file keep its inode, truncating path in place would fault them or show a half
+ * written table
+ */
+static bool snapshot_write_file(const char *path, const snapshot_header_t *header,
+                                const snapshot_writer_t *writer)
+{
+    size_t path_len = strlen(path);
+    char  *tmp_path = malloc(path_len + sizeof(SNAPSHOT_TMP_SUFFIX));
+    check_mem_alloc(tmp_path, "Snapshot temporary path");
+    memcpy(tmp_path, path, path_len);
+    memcpy(tmp_path + path_len, SNAPSHOT_TMP_SUFFIX, sizeof(SNAPSHOT_TMP_SUFFIX));
+
+    FILE *file = fopen(tmp_path, "wb");
+    if (file == NULL)
+    {
+        fprintf(stderr, "ERROR OPENING SNAPSHOT %s\n", tmp_path);
+        free(tmp_path);
+        return FALSE;
+    }
+    size_t slot_count = (size_t) header->slot_count;
+    bool   written    = fwrite(header, sizeof(*header), 1, file) == 1 &&
+                   fwrite(writer->slots, sizeof(snapshot_slot_t), slot_count, file) == slot_count &&
+                   fwrite(writer->heap, 1, writer->heap_size, file) == writer->heap_size &&
+                   fflush(file) == 0 && fsync(fileno(file)) == 0;
+    if (fclose(file) != 0 || !written || rename(tmp_path, path) != 0)
+    {
+        fprintf(stderr, "ERROR WRITING SNAPSHOT %s\n", path);
+        remove(tmp_path);
+        free(tmp_path);
+        return FALSE;
+    }
+    free(tmp_path);
+    return TRUE;
+}
+
+bool snapshot_builder_write(const snapshot_builder_t *builder, const char *path)
+{
+    size_t count      = builder->entries->size;
+    size_t slot_count = HASH_MAP_INITIAL_CAPACITY;
+    while ((double) count > (double) slot_count * HASH_MAP_THRESHOLD)
+    {
+        slot_count *= HASH_MAP_GROWTH_FACTOR;
+    }
+
+    snapshot_writer_t writer = {NULL, slot_count - ONE, NULL, ZERO};
+    for_each_entry_bytes(builder->entries, snapshot_measure_visit, &writer);
+    writer.slots = malloc(slot_count * sizeof(snapshot_slot_t));
+    check_mem_alloc(writer.slots, "Snapshot slots");
+    // Zeroed so the alignment padding between records is deterministic
+    writer.heap = calloc(writer.heap_size + ONE, 1);
+    check_mem_alloc(writer.heap, "Snapshot heap");
+    for (size_t i = 0; i < slot_count; i++)
+    {
+        writer.slots[i] = (snapshot_slot_t) {ZERO, SNAPSHOT_EMPTY_SLOT};
+    }
+    writer.heap_size = ZERO;
+    for_each_entry_bytes(builder->entries, snapshot_place_visit, &writer);
+
+    snapshot_header_t header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, SNAPSHOT_MAGIC, SNAPSHOT_MAGIC_SIZE);
+    header.version      = SNAPSHOT_VERSION;
+    header.header_size  = (u32_t) sizeof(header);
+    header.seed         = SNAPSHOT_SEED;
+    header.entry_count  = count;
+    header.slot_count   = slot_count;
+    header.slots_offset = sizeof(header);
+    header.heap_offset  = sizeof(header) + slot_count * sizeof(snapshot_slot_t);
+    header.heap_size    = writer.heap_size;
+
+    bool written = snapshot_write_file(path, &header, &writer);
+    free(writer.slots);
+    free(writer.heap);
+    return written;
+}
+
+/*
+ * @brief Every section lies inside the mapping and the table has a free slot
+ */
+static bool snapshot_valid(const snapshot_header_t *header, size_t length)
+{
+    u64_t slots = header->slot_count;
+    if (memcmp(header->magic, SNAPSHOT_MAGIC, SNAPSHOT_MAGIC_SIZE) != 0 ||
+        header->version != SNAPSHOT_VERSION || header->header_size != sizeof(*header))
+    {
+        return FALSE;
+    }
+    if (slots == ZERO || (slots & (slots - ONE)) != ZERO || header->entry_count >= slots ||
+        slots > length / sizeof(snapshot_slot_t))
+    {
+        return FALSE;
+    }
+    return header->slots_offset % SNAPSHOT_ALIGNMENT == ZERO &&
+           header->slots_offset <= length - slots * sizeof(snapshot_slot_t) &&
+           header->heap_offset <= length && header->heap_size <= length - header->heap_offset;
+}
+
+hash_map_snapshot_t *snapshot_open(const char *path)
+{
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+    {
+        fprintf(stderr, "ERROR OPENING SNAPSHOT %s\n", path);
+        return NULL;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || (size_t) info.st_size < sizeof(snapshot_header_t))
+    {
+        close(fd);
+        fprintf(stderr, "ERROR INVALID SNAPSHOT %s\n", path);
+        return NULL;
+    }
+    size_t length = (size_t) info.st_size;
+    void  *base   = mmap(NULL, length, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd); // The mapping keeps the file referenced
+    if (base == MAP_FAILED)
+    {
+        fprintf(stderr, "ERROR MAPPING SNAPSHOT %s\n", path);
+        return NULL;
+    }
+    if (!snapshot_valid(base, length))
+    {
+        munmap(base, length);
+        fprintf(stderr, "ERROR INVALID SNAPSHOT %s\n", path);
+        return NULL;
+    }
+
+    hash_map_snapshot_t *snapshot = malloc(sizeof(hash_map_snapshot_t));
+    check_mem_alloc(snapshot, "Snapshot open");
+    snapshot->base   = base;
+    snapshot->length = length;
+    snapshot->header = base;
+    snapshot->slots  = (const void *) (snapshot->base + snapshot->header->slots_offset);
+    snapshot->heap   = snapshot->base + snapshot->header->heap_offset;
+    return snapshot;
+}
+
+void snapshot_close(hash_map_snapshot_t *snapshot)
+{
+    if (snapshot == NULL)
+    {
+        return;
+    }
+    munmap((void *) (uintptr_t) snapshot->base, snapshot->length);
+    free(snapshot);
+}
+
+/*
+ * @brief Value of the record at offset if its key is key, bounds checked against the heap
+ */
+static const void *snapshot_match(const hash_map_snapshot_t *snapshot, u64_t offset,
+                                  const void *key, size_t key_len, size_t *value_len)
+{
+    u64_t heap_size = snapshot->header->heap_size;
+    if (offset > heap_size || heap_size - offset < SNAPSHOT_RECORD_HEADER)
+    {
+        return NULL;
+    }
+    const byte_t *record = snapshot->heap + offset;
+    u32_t         lens[2];
+    memcpy(lens, record, sizeof(lens));
+    if ((u64_t) lens[0] + lens[1] > heap_size - offset - SNAPSHOT_RECORD_HEADER ||
+        lens[0] != key_len || memcmp(record + SNAPSHOT_RECORD_HEADER, key, key_len) != 0)
+    {
+        return NULL;
+    }
+    if (value_len != NULL)
+    {
+        *value_len = lens[1];
+    }
+    return record + SNAPSHOT_RECORD_HEADER + key_len;
+}
+
+const void *snapshot_get(const hash_map_snapshot_t *snapshot, const void *key, size_t key_len,
+                         size_t *value_len)
+{
+    u64_t  hash = hash_murmur64a(key, key_len, snapshot->header->seed);
+    size_t mask = (size_t) snapshot->header->slot_count - ONE;
+    size_t pos  = (size_t) hash & mask;
+
+    // Bounded by the table size so a corrupt file without empty slots cannot loop forever
+    for (size_t probes = 0; probes <= mask; probes++)
+    {
+        const snapshot_slot_t *slot = &snapshot->slots[pos];
+        if (slot->record == SNAPSHOT_EMPTY_SLOT)
+        {
+            return NULL;
+        }
+        if (slot->hash == hash)
+        {
+            const void *value = snapshot_match(snapshot, slot->record, key, key_len, value_len);
+            if (value != NULL)
+            {
+                return value;
+            }
+        }
+        pos = (pos + ONE) & mask;
+    }
+    return NULL;
+}
+
+size_t snapshot_size(const hash_map_snapshot_t *snapshot)
+{
+    return (size_t) snapshot->header->entry_count;
+}
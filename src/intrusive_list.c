@@ -0,0 +1,131 @@
+/**
+ * @file intrusive_list.c
+ * @brief Intrusive doubly linked list
+ */
+
+#include "intrusive_list.h"
+
+#include "utils.h"
+
+void ilist_init(intrusive_list_t *list)
+{
+    list->head = NULL;
+    list->tail = NULL;
+    list->len  = ZERO;
+}
+
+void ilist_insert_before(intrusive_list_t *list, ilist_link_t *at, ilist_link_t *link)
+{
+    ilist_link_t *prev = at != NULL ? at->prev : list->tail;
+    link->prev         = prev;
+    link->next         = at;
+    if (prev != NULL)
+    {
+        prev->next = link;
+    }
+    else
+    {
+        list->head = link;
+    }
+    if (at != NULL)
+    {
+        at->prev = link;
+    }
+    else
+    {
+        list->tail = link;
+    }
+    list->len++;
+}
+
+void ilist_insert_after(intrusive_list_t *list, ilist_link_t *at, ilist_link_t *link)
+{
+    ilist_insert_before(list, at != NULL ? at->next : list->head, link);
+}
+
+void ilist_push_head(intrusive_list_t *list, ilist_link_t *link)
+{
+    ilist_insert_before(list, list->head, link);
+}
+
+void ilist_push_tail(intrusive_list_t *list, ilist_link_t *link)
+{
+    ilist_insert_before(list, NULL, link);
+}
+
+void ilist_remove(intrusive_list_t *list, ilist_link_t *link)
+{
+    if (link->prev != NULL)
+    {
+        link->prev->next = link->next;
+    }
+    else
+    {
+        list->head = link->next;
+    }
+    if (link->next != NULL)
+    {
+        link->next->prev = link->prev;
+    }
+    else
+    {
+        list->tail = link->prev;
+    }
+    link->prev = NULL;
+    link->next = NULL;
+    list->len--;
+}
+
+ilist_link_t *ilist_pop_head(intrusive_list_t *list)
+{
+    ilist_link_t *link = list->head;
+    if (link != NULL)
+    {
+        ilist_remove(list, link);
+    }
+    return link;
+}
+
+ilist_link_t *ilist_pop_tail(intrusive_list_t *list)
+{
+    ilist_link_t *link = list->tail;
+    if (link != NULL)
+    {
+        ilist_remove(list, link);
+    }
+    return link;
+}
+
+ilist_link_t *ilist_get(const intrusive_list_t *list, size_t index)
+{
+    if (index >= list->len)
+    {
+        return NULL;
+    }
+    ilist_link_t *link = NULL;
+    if (index < list->len / 2)
+    {
+        link = list->head;
+        for (size_t i = 0; i < index; i++)
+        {
+            link = link->next;
+        }
+        return link;
+    }
+    link = list->tail;
+    for (size_t i = list->len - ONE; i > index; i--)
+    {
+        link = link->prev;
+    }
+    return link;
+}
+
+size_t ilist_size(const intrusive_list_t *list)
+{
+    return list->len;
+}
+
+bool ilist_is_empty(const intrusive_list_t *list)
+{
+    return list->len == ZERO;
+}
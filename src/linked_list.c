@@ -15,12 +15,128 @@ linked_list_t *init_linkedlist(void)
     linked_list_t *ll = malloc(sizeof(linked_list_t));
     check_mem_alloc(ll, "Linked list init");
     // PARAMETERS
-    ll->len  = 0;
-    ll->head = NULL;
-    ll->tail = NULL;
+    ll->len       = 0;
+    ll->head      = NULL;
+    ll->tail      = NULL;
+    ll->pool      = NULL;
+    ll->owns_pool = false;
     return ll;
 }
 
+linked_list_t *init_linkedlist_pooled(pool_t *pool)
+{
+    linked_list_t *ll = init_linkedlist();
+    ll->owns_pool     = pool == NULL;
+    ll->pool          = pool;
+    if (ll->owns_pool)
+    {
+        ll->pool = pool_init(sizeof(node_t), POOL_DEFAULT_SLAB_OBJECTS);
+    }
+    return ll;
+}
+
+/*
+ * @brief Node from the list pool when it has one, from malloc otherwise
+ */
+static node_t *list_new_node(linked_list_t *list, void *data)
+{
+    if (list->pool == NULL)
+    {
+        return create_node(data);
+    }
+    node_t *new_node = pool_alloc(list->pool);
+    new_node->prev   = NULL;
+    new_node->next   = NULL;
+    new_node->value  = data;
+    return new_node;
+}
+
+static void list_free_node(linked_list_t *list, node_t *node)
+{
+    if (list->pool == NULL)
+    {
+        free(node);
+        return;
+    }
+    pool_free(list->pool, node);
+}
+
+/*
+ * @brief Node at index (< len), walking from whichever end is nearer. O(min(i, n - i))
+ */
+static node_t *list_node_at(const linked_list_t *list, size_t index)
+{
+    node_t *node = NULL;
+    if (index < list->len / 2)
+    {
+        node = list->head;
+        for (size_t i = 0; i < index; i++)
+        {
+            node = node->next;
+        }
+        return node;
+    }
+    node = list->tail;
+    for (size_t i = list->len - (size_t) ONE; i > index; i--)
+    {
+        node = node->prev;
+    }
+    return node;
+}
+
+/*
+ * @brief Link new_node before at, or at the tail when at is NULL. O(1)
+ */
+static void list_link_before(linked_list_t *list, node_t *at, node_t *new_node)
+{
+    node_t *prev   = at != NULL ? at->prev : list->tail;
+    new_node->prev = prev;
+    new_node->next = at;
+    if (prev != NULL)
+    {
+        prev->next = new_node;
+    }
+    else
+    {
+        list->head = new_node;
+    }
+    if (at != NULL)
+    {
+        at->prev = new_node;
+    }
+    else
+    {
+        list->tail = new_node;
+    }
+    list->len++;
+}
+
+/*
+ * @brief Detach node from the list without freeing it. O(1)
+ */
+static void list_unlink(linked_list_t *list, node_t *node)
+{
+    node_t *prev = node->prev;
+    node_t *next = node->next;
+    if (prev != NULL)
+    {
+        prev->next = next;
+    }
+    else
+    {
+        list->head = next;
+    }
+    if (next != NULL)
+    {
+        next->prev = prev;
+    }
+    else
+    {
+        list->tail = prev;
+    }
+    list->len--;
+}
+
 void delete_linkedlist(linked_list_t *list)
 {
 
@@ -32,21 +148,25 @@ void delete_linkedlist(linked_list_t *list)
     // Caso facil, no hay elementos en la lista. Free de la estructura
     if (list->len == 0)
     {
+        pool_destroy(list->owns_pool ? list->pool : NULL);
         free(list);
         return;
     }
 
     node_t *base = list->tail;
 
-    while (base->prev != NULL)
+    // With a private pool the nodes go away with their slabs, only the values are walked
+    while (base != NULL)
     {
         node_t *new_base = base->prev;
         free(base->value);
-        free(base);
+        if (list->owns_pool == false)
+        {
+            list_free_node(list, base);
+        }
         base = new_base;
     }
-    free(base->value);
-    free(base);
+    pool_destroy(list->owns_pool ? list->pool : NULL);
     free(list);
 }
 
@@ -62,7 +182,7 @@ node_t *create_node(void *data)
 
 void push_node(linked_list_t *list, void *data)
 {
-    node_t *new_node = create_node(data);
+    node_t *new_node = list_new_node(list, data);
     if (list->len == (size_t) ZERO)
     {
         list->head = new_node;
@@ -96,7 +216,7 @@ void *pop_head(linked_list_t *list)
     }
     list->len--;
     void *value = return_node->value;
-    free(return_node);
+    list_free_node(list, return_node);
     return value;
 }
 
@@ -120,7 +240,7 @@ void *pop_tail(linked_list_t *list)
 
     list->len--;
     void *return_value = return_node->value;
-    free(return_node);
+    list_free_node(list, return_node);
     return return_value;
 }
 
@@ -132,7 +252,7 @@ void insert_node(linked_list_t *list, size_t index, void *data)
         throw_error("Too much index size for the ll");
     }
 
-    node_t *node_to_insert = create_node(data);
+    node_t *node_to_insert = list_new_node(list, data);
 
     // Case ll empty and insert in index 0(ALLOWED)
     if (list->len == 0 && index == 0)
@@ -163,20 +283,8 @@ void insert_node(linked_list_t *list, size_t index, void *data)
         return;
     }
 
-    node_t *iter_node = list->head;
-    node_t *next_node = list->head->next;
-    // general case. Navigate till the element and insert it
-    for (size_t i = 1; i < index; i++)
-    {
-        iter_node = iter_node->next;
-        next_node = iter_node->next;
-    }
-
-    node_to_insert->next = iter_node->next;
-    node_to_insert->prev = iter_node;
-    next_node->prev      = node_to_insert;
-    iter_node->next      = node_to_insert;
-    list->len++;
+    // general case. Navigate from the nearer end till the element and insert before it
+    list_link_before(list, list_node_at(list, index), node_to_insert);
 }
 
 void remove_node(linked_list_t *list, size_t index)
@@ -208,18 +316,11 @@ void remove_node(linked_list_t *list, size_t index)
         return;
     }
 
-    // General case. Navigate till the index of the element
-    node_t *index_node = list->head;
-
-    for (size_t i = 0; i < index; i++)
-    {
-        index_node = index_node->next;
-    }
-    ((node_t *) index_node->prev)->next = index_node->next;
-    ((node_t *) index_node->next)->prev = index_node->prev;
+    // General case. Navigate from the nearer end till the index of the element
+    node_t *index_node = list_node_at(list, index);
+    list_unlink(list, index_node);
     free(index_node->value);
-    free(index_node);
-    list->len--;
+    list_free_node(list, index_node);
 }
 
 size_t get_linked_list_size(const linked_list_t *list)
@@ -238,18 +339,323 @@ void *get_element(linked_list_t *list, size_t index)
     {
         throw_error("No index in list");
     }
-    if (index == 0)
+    return list_node_at(list, index)->value;
+}
+
+void *rec_get_element(node_t *actual, size_t index)
+{
+    // Iterative despite the name, one stack frame per hop overflowed on long lists
+    while (index > 0)
     {
-        return list->head->value;
+        actual = actual->next;
+        index--;
     }
-    return rec_get_element(list->head->next, index - (size_t) ONE);
+    return actual->value;
 }
 
-void *rec_get_element(node_t *actual, size_t index)
+/* ================================================================================================
+ * CURSORS
+ * ================================================================================================
+ */
+
+list_cursor_t list_cursor_front(linked_list_t *list)
 {
-    if (index == 0)
+    list_cursor_t cursor = {list, list->head, ZERO};
+    return cursor;
+}
+
+list_cursor_t list_cursor_back(linked_list_t *list)
+{
+    list_cursor_t cursor = {list, list->tail, list->len == 0 ? ZERO : list->len - (size_t) ONE};
+    return cursor;
+}
+
+list_cursor_t list_cursor_at(linked_list_t *list, size_t index)
+{
+    if (index > list->len)
+    {
+        throw_error("Cursor index out of the ll");
+    }
+    list_cursor_t cursor = {list, NULL, index};
+    if (index < list->len)
+    {
+        cursor.node = list_node_at(list, index);
+    }
+    return cursor;
+}
+
+bool list_cursor_valid(const list_cursor_t *cursor)
+{
+    return cursor->node != NULL;
+}
+
+size_t list_cursor_index(const list_cursor_t *cursor)
+{
+    return cursor->index;
+}
+
+void *list_cursor_get(const list_cursor_t *cursor)
+{
+    if (cursor->node == NULL)
+    {
+        throw_error("Cursor is at the end of the ll");
+    }
+    return cursor->node->value;
+}
+
+void list_cursor_next(list_cursor_t *cursor)
+{
+    if (cursor->node == NULL)
+    {
+        cursor->node  = cursor->list->head;
+        cursor->index = ZERO;
+        return;
+    }
+    cursor->node = cursor->node->next;
+    cursor->index++;
+}
+
+void list_cursor_prev(list_cursor_t *cursor)
+{
+    if (cursor->node == NULL)
+    {
+        cursor->node  = cursor->list->tail;
+        cursor->index = cursor->node != NULL ? cursor->list->len - (size_t) ONE : ZERO;
+        return;
+    }
+    cursor->node = cursor->node->prev;
+    cursor->index--;
+    if (cursor->node == NULL)
+    {
+        cursor->index = cursor->list->len;
+    }
+}
+
+void list_cursor_insert_before(list_cursor_t *cursor, void *data)
+{
+    list_link_before(cursor->list, cursor->node, list_new_node(cursor->list, data));
+    cursor->index++;
+}
+
+void list_cursor_insert_after(list_cursor_t *cursor, void *data)
+{
+    node_t *at = cursor->node != NULL ? cursor->node->next : cursor->list->head;
+    list_link_before(cursor->list, at, list_new_node(cursor->list, data));
+    if (cursor->node == NULL)
+    {
+        cursor->index++;
+    }
+}
+
+void *list_cursor_remove(list_cursor_t *cursor)
+{
+    node_t *node = cursor->node;
+    if (node == NULL)
     {
-        return actual->value;
+        throw_error("Cursor is at the end of the ll");
     }
-    return rec_get_element((node_t *) actual->next, index - (size_t) ONE);
+    void *value  = node->value;
+    cursor->node = node->next;
+    list_unlink(cursor->list, node);
+    list_free_node(cursor->list, node);
+    return value;
+}
+
+/* ================================================================================================
+ * SORT, MERGE, SPLICE AND SPLIT. Nodes are only relinked, never allocated or copied.
+ * ================================================================================================
+ */
+
+/*
+ * @brief Cut the first count nodes off *rest as a NULL terminated run. O(count)
+ */
+static node_t *list_cut_run(node_t **rest, size_t count)
+{
+    node_t *run  = *rest;
+    node_t *last = NULL;
+    for (size_t i = 0; i < count && *rest != NULL; i++)
+    {
+        last  = *rest;
+        *rest = last->next;
+    }
+    if (last != NULL)
+    {
+        last->next = NULL;
+    }
+    return run;
+}
+
+/*
+ * @brief Stable merge of two NULL terminated runs through next only. O(a + b)
+ */
+static node_t *list_merge_runs(node_t *a, node_t *b, list_cmp_t cmp, node_t **tail)
+{
+    node_t  dummy = {NULL, NULL, NULL};
+    node_t *last  = &dummy;
+    while (a != NULL && b != NULL)
+    {
+        // Ties take from a so equal values keep their order
+        if (cmp(a->value, b->value) <= 0)
+        {
+            last->next = a;
+            a          = a->next;
+        }
+        else
+        {
+            last->next = b;
+            b          = b->next;
+        }
+        last = last->next;
+    }
+    last->next = a != NULL ? a : b;
+    while (last->next != NULL)
+    {
+        last = last->next;
+    }
+    *tail = last;
+    return dummy.next;
+}
+
+/*
+ * @brief Rebuild prev links and the tail after relinking through next. O(n)
+ */
+static void list_relink_prev(linked_list_t *list)
+{
+    node_t *prev = NULL;
+    for (node_t *node = list->head; node != NULL; node = node->next)
+    {
+        node->prev = prev;
+        prev       = node;
+    }
+    list->tail = prev;
+}
+
+static void list_check_same_allocator(const linked_list_t *dst, const linked_list_t *src)
+{
+    if (dst->pool != src->pool || dst->owns_pool || src->owns_pool)
+    {
+        throw_error("Lists must share their node allocator to exchange nodes");
+    }
+}
+
+void list_sort(linked_list_t *list, list_cmp_t cmp)
+{
+    node_t *head = list->head;
+    for (size_t width = 1; head != NULL; width *= 2)
+    {
+        node_t *rest   = head;
+        node_t *tail   = NULL;
+        size_t  merges = 0;
+        head           = NULL;
+        while (rest != NULL)
+        {
+            node_t *left       = list_cut_run(&rest, width);
+            node_t *right      = list_cut_run(&rest, width);
+            node_t *run_tail   = NULL;
+            node_t *merged_run = list_merge_runs(left, right, cmp, &run_tail);
+            if (tail != NULL)
+            {
+                tail->next = merged_run;
+            }
+            else
+            {
+                head = merged_run;
+            }
+            tail = run_tail;
+            merges++;
+        }
+        if (merges <= 1)
+        {
+            break;
+        }
+    }
+    list->head = head;
+    list_relink_prev(list);
+}
+
+void list_merge(linked_list_t *dst, linked_list_t *src, list_cmp_t cmp)
+{
+    list_check_same_allocator(dst, src);
+    node_t *tail = NULL;
+    dst->head    = list_merge_runs(dst->head, src->head, cmp, &tail);
+    dst->len += src->len;
+    list_relink_prev(dst);
+
+    src->head = NULL;
+    src->tail = NULL;
+    src->len  = 0;
+}
+
+void list_splice(list_cursor_t *cursor, linked_list_t *src)
+{
+    linked_list_t *dst = cursor->list;
+    list_check_same_allocator(dst, src);
+    if (src->len == 0)
+    {
+        return;
+    }
+
+    // Link src->head..src->tail between prev and the cursor node
+    node_t *at   = cursor->node;
+    node_t *prev = at != NULL ? at->prev : dst->tail;
+
+    src->head->prev = prev;
+    src->tail->next = at;
+    if (prev != NULL)
+    {
+        prev->next = src->head;
+    }
+    else
+    {
+        dst->head = src->head;
+    }
+    if (at != NULL)
+    {
+        at->prev = src->tail;
+    }
+    else
+    {
+        dst->tail = src->tail;
+    }
+    dst->len += src->len;
+    cursor->index += src->len;
+
+    src->head = NULL;
+    src->tail = NULL;
+    src->len  = 0;
+}
+
+linked_list_t *list_split(list_cursor_t *cursor)
+{
+    linked_list_t *list = cursor->list;
+    if (list->owns_pool)
+    {
+        throw_error("Cannot split a list that owns its node pool");
+    }
+    linked_list_t *rest = init_linkedlist();
+    rest->pool          = list->pool;
+    if (cursor->node == NULL)
+    {
+        return rest;
+    }
+
+    rest->head = cursor->node;
+    rest->tail = list->tail;
+    rest->len  = list->len - cursor->index;
+    list->tail = cursor->node->prev;
+    list->len  = cursor->index;
+    if (list->tail != NULL)
+    {
+        list->tail->next = NULL;
+    }
+    else
+    {
+        list->head = NULL;
+    }
+    rest->head->prev = NULL;
+
+    // The cursor keeps its node, which is now the head of rest
+    cursor->list  = rest;
+    cursor->index = 0;
+    return rest;
 }
@@ -0,0 +1,292 @@
+/**
+ * @file lru_cache.c
+ * @brief LRU cache on hash_map_oa_t and mod_ll_t, and its mutex sharded version
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "lru_cache.h"
+
+#include "utils.h"
+
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#define LRU_SHARD_MUL  0x9E3779B1U // 2^32 / golden ratio, independent of the in-shard hash
+#define LRU_CACHE_LINE 64
+
+lru_cache_t *lru_init(size_t max_entries, size_t max_bytes)
+{
+    lru_cache_t *cache = malloc(sizeof(lru_cache_t));
+    check_mem_alloc(cache, "LRU cache init");
+    cache->index       = init_hash_map_oa();
+    cache->order       = mod_init_linked_list();
+    cache->max_entries = max_entries;
+    cache->max_bytes   = max_bytes;
+    cache->bytes       = ZERO;
+    cache->hits        = ZERO;
+    cache->misses      = ZERO;
+    cache->evictions   = ZERO;
+    return cache;
+}
+
+void lru_destroy(lru_cache_t *cache)
+{
+    if (cache == NULL)
+    {
+        return;
+    }
+    for (entry_t *entry = cache->order->head; entry != NULL; entry = entry->next)
+    {
+        free(entry->data);
+    }
+    // The nodes belong to the map, the queue is emptied before it is freed
+    cache->order->head = NULL;
+    cache->order->tail = NULL;
+    cache->order->len  = ZERO;
+    mod_delete_linked_list(cache->order);
+    delete_hash_map_oa(cache->index);
+    free(cache);
+}
+
+/*
+ * @brief Unlink node from the queue, free its value and drop it (and the node) from the map
+ */
+static void lru_drop(lru_cache_t *cache, lru_node_t *node)
+{
+    mod_detach_entry(cache->order, &node->link);
+    free(node->link.data);
+    cache->bytes -= node->bytes;
+    remove_entry_oa(cache->index, node->link.key);
+}
+
+static bool lru_over_budget(const lru_cache_t *cache)
+{
+    return (cache->max_entries != ZERO && cache->index->size > cache->max_entries) ||
+           (cache->max_bytes != ZERO && cache->bytes > cache->max_bytes);
+}
+
+void *lru_get(lru_cache_t *cache, u32_t key)
+{
+    entry_t *entry = get_entry_oa(cache->index, key);
+    if (entry == NULL)
+    {
+        cache->misses++;
+        return NULL;
+    }
+    if (entry != cache->order->head)
+    {
+        mod_detach_entry(cache->order, entry);
+        mod_attach_head(cache->order, entry);
+    }
+    cache->hits++;
+    return entry->data;
+}
+
+bool lru_put(lru_cache_t *cache, u32_t key, void *value, size_t bytes)
+{
+    if (cache->max_bytes != ZERO && bytes > cache->max_bytes)
+    {
+        free(value);
+        return FALSE;
+    }
+    lru_node_t *node = get_entry_oa(cache->index, key);
+    if (node != NULL)
+    {
+        free(node->link.data);
+        node->link.data = value;
+        cache->bytes    = cache->bytes - node->bytes + bytes;
+        node->bytes     = bytes;
+        mod_detach_entry(cache->order, &node->link);
+    }
+    else
+    {
+        node = malloc(sizeof(lru_node_t));
+        check_mem_alloc(node, "LRU cache node");
+        node->link.key  = key;
+        node->link.data = value;
+        node->bytes     = bytes;
+        cache->bytes += bytes;
+        add_entry_oa(cache->index, key, node);
+    }
+    mod_attach_head(cache->order, &node->link);
+
+    // The new head fits both bounds on its own, so the loop stops before reaching it
+    while (lru_over_budget(cache))
+    {
+        lru_drop(cache, (lru_node_t *) (void *) cache->order->tail);
+        cache->evictions++;
+    }
+    return TRUE;
+}
+
+bool lru_remove(lru_cache_t *cache, u32_t key)
+{
+    lru_node_t *node = get_entry_oa(cache->index, key);
+    if (node == NULL)
+    {
+        return FALSE;
+    }
+    lru_drop(cache, node);
+    return TRUE;
+}
+
+/* ================================================================================================
+ * SHARDED
+ * ================================================================================================
+ */
+
+typedef struct lru_shard_t
+{
+    _Alignas(LRU_CACHE_LINE) pthread_mutex_t lock;
+    lru_cache_t *cache;
+} lru_shard_t;
+
+struct lru_sharded_t
+{
+    lru_shard_t *shards;
+    size_t       shard_count;
+    u32_t        shard_shift; // 32 - log2(shard_count)
+};
+
+/*
+ * @brief Shard of key from the top bits of a multiplicative hash, the shard's own map indexes
+ * with the low bits of a different mix so both choices stay uncorrelated
+ */
+static lru_shard_t *lru_shard(const lru_sharded_t *cache, u32_t key)
+{
+    // Widened first, a single shard shifts by the full 32 bits
+    u64_t product = (u64_t) (key * LRU_SHARD_MUL);
+    return &cache->shards[(size_t) (product >> cache->shard_shift)];
+}
+
+static void lru_check(int status, const char *error_type)
+{
+    if (status != 0)
+    {
+        throw_error(error_type);
+    }
+}
+
+/*
+ * @brief Share of total for shard index: the remainder goes one unit each to the first shards,
+ * so the shares add up to total exactly
+ */
+static size_t lru_share(size_t total, size_t shards, size_t index)
+{
+    return total / shards + (index < total % shards ? ONE : ZERO);
+}
+
+/*
+ * @brief Halve shard_count (a power of two) until every shard gets at least one unit of a set
+ * bound, a zero share would turn that bound off for the shard
+ */
+static size_t lru_cap_shards(size_t shard_count, size_t bound)
+{
+    while (bound != ZERO && shard_count > bound)
+    {
+        shard_count /= 2U;
+    }
+    return shard_count;
+}
+
+lru_sharded_t *lru_sharded_init(size_t shard_count, size_t max_entries, size_t max_bytes)
+{
+    if (shard_count == ZERO)
+    {
+        shard_count = LRU_DEFAULT_SHARDS;
+    }
+    u32_t bits = ZERO;
+    while (((size_t) ONE << bits) < shard_count)
+    {
+        bits++;
+    }
+    if (bits > 32U)
+    {
+        throw_error(" TOO MANY SHARDS");
+    }
+    shard_count = lru_cap_shards(lru_cap_shards((size_t) ONE << bits, max_entries), max_bytes);
+    while (((size_t) ONE << bits) > shard_count)
+    {
+        bits--;
+    }
+
+    lru_sharded_t *cache = malloc(sizeof(lru_sharded_t));
+    check_mem_alloc(cache, "LRU sharded init");
+    cache->shard_count = shard_count;
+    cache->shard_shift = 32U - bits;
+    cache->shards      = aligned_alloc(LRU_CACHE_LINE, cache->shard_count * sizeof(lru_shard_t));
+    check_mem_alloc(cache->shards, "LRU sharded shards");
+
+    for (size_t i = 0; i < cache->shard_count; i++)
+    {
+        lru_check(pthread_mutex_init(&cache->shards[i].lock, NULL), " INITIALIZING SHARD LOCK");
+        cache->shards[i].cache = lru_init(lru_share(max_entries, cache->shard_count, i),
+                                          lru_share(max_bytes, cache->shard_count, i));
+    }
+    return cache;
+}
+
+void lru_sharded_destroy(lru_sharded_t *cache)
+{
+    if (cache == NULL)
+    {
+        return;
+    }
+    for (size_t i = 0; i < cache->shard_count; i++)
+    {
+        lru_destroy(cache->shards[i].cache);
+        pthread_mutex_destroy(&cache->shards[i].lock);
+    }
+    free(cache->shards);
+    free(cache);
+}
+
+bool lru_sharded_get(lru_sharded_t *cache, u32_t key, hash_map_visit_t reader, void *ctx)
+{
+    lru_shard_t *shard = lru_shard(cache, key);
+    lru_check(pthread_mutex_lock(&shard->lock), " LOCKING SHARD");
+    void *value = lru_get(shard->cache, key);
+    if (value != NULL && reader != NULL)
+    {
+        reader(key, value, ctx);
+    }
+    pthread_mutex_unlock(&shard->lock);
+    return value != NULL;
+}
+
+bool lru_sharded_put(lru_sharded_t *cache, u32_t key, void *value, size_t bytes)
+{
+    lru_shard_t *shard = lru_shard(cache, key);
+    lru_check(pthread_mutex_lock(&shard->lock), " LOCKING SHARD");
+    bool cached = lru_put(shard->cache, key, value, bytes);
+    pthread_mutex_unlock(&shard->lock);
+    return cached;
+}
+
+bool lru_sharded_remove(lru_sharded_t *cache, u32_t key)
+{
+    lru_shard_t *shard = lru_shard(cache, key);
+    lru_check(pthread_mutex_lock(&shard->lock), " LOCKING SHARD");
+    bool removed = lru_remove(shard->cache, key);
+    pthread_mutex_unlock(&shard->lock);
+    return removed;
+}
+
+size_t lru_sharded_size(lru_sharded_t *cache)
+{
+    size_t size = ZERO;
+    for (size_t i = 0; i < cache->shard_count; i++)
+    {
+        lru_check(pthread_mutex_lock(&cache->shards[i].lock), " LOCKING SHARD");
+        size += cache->shards[i].cache->index->size;
+        pthread_mutex_unlock(&cache->shards[i].lock);
+    }
+    return size;
+}
+
+size_t lru_sharded_shard_count(const lru_sharded_t *cache)
+{
+    return cache->shard_count;
+}
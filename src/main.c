@@ -3,12 +3,28 @@
  * @brief Tests for dynamic_array and linked_list implementations
  */
 
+#include "compact_list.h"
+#include "concurrent_map.h"
+#include "deque.h"
 #include "dynamic_array.h"
+#include "hash.h"
+#include "hash_map.h"
+#include "hash_map_snapshot.h"
+#include "intrusive_list.h"
 #include "linked_list.h"
+#include "lru_cache.h"
+#include "perfect_hash.h"
+#include "pool.h"
+#include "segmented_array.h"
+#include "skip_list.h"
+#include "typed_array.h"
+#include "unrolled_list.h"
 
 #include <assert.h>
+#include <pthread.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 /* ============================================
  *          HELPER FUNCTIONS
@@ -22,6 +38,37 @@ static int *make_int(int value)
     return ptr;
 }
 
+typedef struct point_t
+{
+    int    x;
+    double y;
+} point_t;
+
+typedef struct job_t
+{
+    int          id;
+    ilist_link_t queue_link;
+    ilist_link_t owner_link;
+} job_t;
+
+DYNARRAY_DEFINE(int_array, int)
+DYNARRAY_DEFINE(point_array, point_t)
+
+static int cmp_int(const void *a, const void *b)
+{
+    int left  = *(const int *) a;
+    int right = *(const int *) b;
+    return (left > right) - (left < right);
+}
+
+// Orders by tens only, so values with the same tens digit compare equal
+static int cmp_tens(const void *a, const void *b)
+{
+    int left  = *(const int *) a / 10;
+    int right = *(const int *) b / 10;
+    return (left > right) - (left < right);
+}
+
 /* ============================================
  *          DYNAMIC ARRAY TESTS
  * ============================================ */
@@ -461,6 +508,510 @@ static void test_da_push_pop_interleaved(void)
     printf("PASSED\n");
 }
 
+static void test_da_geometric_growth(void)
+{
+    printf("Test: DA grows capacity geometrically... ");
+    dynamic_array_t *arr = dynarray_init();
+
+    int    x        = 1;
+    size_t expected = DYNARRAY_INLINE_CAPACITY;
+    assert(dynarray_capacity(arr) == expected);
+    // Each push past a full buffer multiplies the capacity, starting from the inline buffer
+    for (int round = 0; round < 3; round++)
+    {
+        while (dynarray_size(arr) < expected + 1)
+        {
+            dynarray_push(arr, &x);
+        }
+        expected *= DYNARRAY_GROWTH_FACTOR;
+        assert(dynarray_capacity(arr) == expected);
+    }
+    assert(dynarray_size(arr) == expected / DYNARRAY_GROWTH_FACTOR + 1);
+
+    dynarray_destroy(arr);
+    printf("PASSED\n");
+}
+
+static void test_da_init_with_capacity(void)
+{
+    printf("Test: DA init with capacity... ");
+    dynamic_array_t *arr = dynarray_init_with_capacity(100);
+
+    assert(dynarray_capacity(arr) == 100);
+    assert(dynarray_is_empty(arr) == true);
+
+    int values[100];
+    for (int i = 0; i < 100; i++)
+    {
+        values[i] = i;
+        dynarray_push(arr, &values[i]);
+    }
+    assert(dynarray_capacity(arr) == 100);
+    assert(*(int *) dynarray_get(arr, 99) == 99);
+
+    dynarray_destroy(arr);
+    printf("PASSED\n");
+}
+
+static void test_da_reserve(void)
+{
+    printf("Test: DA reserve... ");
+    dynamic_array_t *arr = dynarray_init();
+
+    int a = 7;
+    dynarray_push(arr, &a);
+
+    assert(dynarray_reserve(arr, 1000) == true);
+    assert(dynarray_capacity(arr) == 1000);
+    assert(dynarray_size(arr) == 1);
+    assert(*(int *) dynarray_get(arr, 0) == 7);
+
+    // Reserving less than the current capacity never shrinks
+    assert(dynarray_reserve(arr, 10) == true);
+    assert(dynarray_capacity(arr) == 1000);
+
+    dynarray_destroy(arr);
+    printf("PASSED\n");
+}
+
+static void test_da_shrink_to_fit(void)
+{
+    printf("Test: DA shrink to fit... ");
+    dynamic_array_t *arr = dynarray_init();
+
+    int values[40];
+    for (int i = 0; i < 40; i++)
+    {
+        values[i] = i;
+        dynarray_push(arr, &values[i]);
+    }
+    assert(dynarray_shrink_to_fit(arr) == true);
+    assert(dynarray_capacity(arr) == 40);
+    assert(*(int *) dynarray_get(arr, 39) == 39);
+
+    while (dynarray_is_empty(arr) == false)
+    {
+        dynarray_pop(arr);
+    }
+    assert(dynarray_shrink_to_fit(arr) == true);
+    assert(dynarray_capacity(arr) == DYNARRAY_INLINE_CAPACITY);
+
+    dynarray_push(arr, &values[5]);
+    dynarray_push(arr, &values[6]);
+    assert(*(int *) dynarray_get(arr, 1) == 6);
+
+    dynarray_destroy(arr);
+    printf("PASSED\n");
+}
+
+static void test_da_insert_range(void)
+{
+    printf("Test: DA insert range in the middle... ");
+    dynamic_array_t *arr = dynarray_init();
+
+    int values[6] = {0, 1, 2, 3, 4, 5};
+    dynarray_push(arr, &values[0]);
+    dynarray_push(arr, &values[5]);
+
+    void *middle[4] = {&values[1], &values[2], &values[3], &values[4]};
+    assert(dynarray_insert_range(arr, 1, middle, 4) == true);
+    assert(dynarray_insert_range(arr, 7, middle, 1) == false);
+
+    assert(dynarray_size(arr) == 6);
+    for (int i = 0; i < 6; i++)
+    {
+        assert(*(int *) dynarray_get(arr, (size_t) i) == i);
+    }
+
+    dynarray_destroy(arr);
+    printf("PASSED\n");
+}
+
+static void test_da_erase_range(void)
+{
+    printf("Test: DA erase range... ");
+    dynamic_array_t *arr = dynarray_init();
+
+    int values[10];
+    for (int i = 0; i < 10; i++)
+    {
+        values[i] = i;
+        dynarray_push(arr, &values[i]);
+    }
+
+    assert(dynarray_erase_range(arr, 2, 5) == true);
+    assert(dynarray_size(arr) == 5);
+    assert(*(int *) dynarray_get(arr, 1) == 1);
+    assert(*(int *) dynarray_get(arr, 2) == 7);
+    assert(*(int *) dynarray_get(arr, 4) == 9);
+
+    assert(dynarray_erase_range(arr, 3, 3) == false);
+    assert(dynarray_erase_range(arr, 3, 2) == true);
+    assert(dynarray_size(arr) == 3);
+
+    dynarray_destroy(arr);
+    printf("PASSED\n");
+}
+
+static void test_da_push_n(void)
+{
+    printf("Test: DA push n grows once... ");
+    dynamic_array_t *arr = dynarray_init();
+
+    int   values[100];
+    void *ptrs[100];
+    for (int i = 0; i < 100; i++)
+    {
+        values[i] = i;
+        ptrs[i]   = &values[i];
+    }
+
+    assert(dynarray_push_n(arr, ptrs, 100) == true);
+    assert(dynarray_size(arr) == 100);
+    assert(dynarray_capacity(arr) == 128);
+    assert(*(int *) dynarray_get(arr, 99) == 99);
+
+    dynarray_destroy(arr);
+    printf("PASSED\n");
+}
+
+static void test_da_append_array(void)
+{
+    printf("Test: DA append array (and itself)... ");
+    dynamic_array_t *arr   = dynarray_init();
+    dynamic_array_t *other = dynarray_init();
+
+    int a = 1;
+    int b = 2;
+    dynarray_push(arr, &a);
+    dynarray_push(other, &b);
+    dynarray_push(other, &b);
+
+    assert(dynarray_append_array(arr, other) == true);
+    assert(dynarray_size(arr) == 3);
+    assert(*(int *) dynarray_get(arr, 2) == 2);
+
+    assert(dynarray_append_array(arr, arr) == true);
+    assert(dynarray_size(arr) == 6);
+    assert(*(int *) dynarray_get(arr, 3) == 1);
+    assert(*(int *) dynarray_get(arr, 5) == 2);
+
+    dynarray_destroy(other);
+    dynarray_destroy(arr);
+    printf("PASSED\n");
+}
+
+static void test_da_init_no_data_alloc(void)
+{
+    printf("Test: DA init uses the inline buffer... ");
+    dynamic_array_t *arr = dynarray_init();
+
+    assert(arr->data == arr->inline_data);
+    assert(dynarray_capacity(arr) == DYNARRAY_INLINE_CAPACITY);
+
+    dynarray_destroy(arr);
+    printf("PASSED\n");
+}
+
+static void test_da_inline_on_stack(void)
+{
+    printf("Test: DA on the stack spills to the heap... ");
+    dynamic_array_t arr;
+    dynarray_init_inline(&arr);
+
+    int values[DYNARRAY_INLINE_CAPACITY + 1];
+    for (int i = 0; i < DYNARRAY_INLINE_CAPACITY; i++)
+    {
+        values[i] = i;
+        assert(dynarray_push(&arr, &values[i]) == true);
+    }
+    assert(arr.data == arr.inline_data);
+
+    values[DYNARRAY_INLINE_CAPACITY] = DYNARRAY_INLINE_CAPACITY;
+    dynarray_set(&arr, 0, &values[DYNARRAY_INLINE_CAPACITY]);
+    assert(arr.data != arr.inline_data);
+    assert(dynarray_size(&arr) == DYNARRAY_INLINE_CAPACITY + 1);
+    assert(*(int *) dynarray_get(&arr, 0) == DYNARRAY_INLINE_CAPACITY);
+    assert(*(int *) dynarray_get(&arr, DYNARRAY_INLINE_CAPACITY) == DYNARRAY_INLINE_CAPACITY - 1);
+
+    dynarray_release(&arr);
+    assert(dynarray_is_empty(&arr) == true);
+    assert(arr.data == arr.inline_data);
+    printf("PASSED\n");
+}
+
+static void test_da_inline_shrink_back(void)
+{
+    printf("Test: DA shrink moves back into the inline buffer... ");
+    dynamic_array_t arr;
+    dynarray_init_inline(&arr);
+
+    int values[20];
+    for (int i = 0; i < 20; i++)
+    {
+        values[i] = i;
+        dynarray_push(&arr, &values[i]);
+    }
+    dynarray_erase_range(&arr, 3, 15);
+    assert(dynarray_shrink_to_fit(&arr) == true);
+
+    assert(arr.data == arr.inline_data);
+    assert(dynarray_size(&arr) == 5);
+    assert(*(int *) dynarray_get(&arr, 2) == 2);
+    assert(*(int *) dynarray_get(&arr, 3) == 18);
+
+    dynarray_release(&arr);
+    printf("PASSED\n");
+}
+
+/* ============================================
+ *          TYPED ARRAY TESTS
+ * ============================================ */
+
+static void test_ta_push_get_pop(void)
+{
+    printf("Test: TA push, get and pop values... ");
+    int_array_t *arr = int_array_init();
+
+    for (int i = 0; i < 1000; i++)
+    {
+        assert(int_array_push(arr, i * 2) == true);
+    }
+    assert(int_array_size(arr) == 1000);
+    assert(*int_array_get(arr, 0) == 0);
+    assert(*int_array_get(arr, 999) == 1998);
+    assert(int_array_get(arr, 1000) == NULL);
+
+    int out = 0;
+    assert(int_array_pop(arr, &out) == true);
+    assert(out == 1998);
+    assert(int_array_size(arr) == 999);
+
+    int_array_destroy(arr);
+    printf("PASSED\n");
+}
+
+static void test_ta_pop_empty(void)
+{
+    printf("Test: TA pop from empty... ");
+    int_array_t *arr = int_array_init();
+
+    int out = 42;
+    assert(int_array_pop(arr, &out) == false);
+    assert(out == 42);
+    assert(int_array_is_empty(arr) == true);
+
+    int_array_destroy(arr);
+    printf("PASSED\n");
+}
+
+static void test_ta_set_insert_erase(void)
+{
+    printf("Test: TA set, insert and erase... ");
+    int_array_t *arr = int_array_init();
+
+    int_array_push(arr, 1);
+    int_array_push(arr, 3);
+    assert(int_array_insert(arr, 1, 2) == true);
+    assert(int_array_insert(arr, 3, 4) == true);
+    assert(int_array_insert(arr, 10, 5) == false);
+    assert(int_array_set(arr, 0, 0) == true);
+    assert(int_array_set(arr, 4, 0) == false);
+
+    assert(int_array_size(arr) == 4);
+    assert(*int_array_get(arr, 0) == 0);
+    assert(*int_array_get(arr, 1) == 2);
+    assert(*int_array_get(arr, 3) == 4);
+
+    assert(int_array_erase(arr, 1) == true);
+    assert(int_array_erase(arr, 3) == false);
+    assert(int_array_size(arr) == 3);
+    assert(*int_array_get(arr, 1) == 3);
+
+    int_array_destroy(arr);
+    printf("PASSED\n");
+}
+
+static void test_ta_struct_values(void)
+{
+    printf("Test: TA struct values stored inline... ");
+    point_array_t *arr = point_array_init();
+
+    for (int i = 0; i < 100; i++)
+    {
+        point_t p = {i, (double) i / 2};
+        point_array_push(arr, p);
+    }
+    assert(point_array_get(arr, 50)->x == 50);
+    assert(point_array_get(arr, 50)->y == 25.0);
+    assert(point_array_get(arr, 1) == point_array_get(arr, 0) + 1);
+
+    point_array_destroy(arr);
+    printf("PASSED\n");
+}
+
+/* ============================================
+ *          SEGMENTED ARRAY TESTS
+ * ============================================ */
+
+static void test_sa_push_get_across_chunks(void)
+{
+    printf("Test: SA push and get across chunks... ");
+    segmented_array_t *arr   = segarray_init();
+    size_t             count = SEGARRAY_CHUNK_SIZE * 3 + 5;
+
+    int values[2] = {0, 1};
+    for (size_t i = 0; i < count; i++)
+    {
+        assert(segarray_push(arr, &values[i % 2]) == true);
+    }
+    assert(segarray_size(arr) == count);
+    assert(arr->chunk_count == 4);
+    assert(*(int *) segarray_get(arr, SEGARRAY_CHUNK_SIZE) == 0);
+    assert(*(int *) segarray_get(arr, SEGARRAY_CHUNK_SIZE + 1) == 1);
+    assert(segarray_get(arr, count) == NULL);
+
+    segarray_destroy(arr);
+    printf("PASSED\n");
+}
+
+static void test_sa_stable_addresses(void)
+{
+    printf("Test: SA slot addresses survive growth... ");
+    segmented_array_t *arr = segarray_init();
+
+    int a = 1;
+    int b = 2;
+    segarray_push(arr, &a);
+    void **first = segarray_slot(arr, 0);
+
+    for (size_t i = 0; i < SEGARRAY_CHUNK_SIZE * 4; i++)
+    {
+        segarray_push(arr, &b);
+    }
+    assert(segarray_slot(arr, 0) == first);
+    assert(*first == &a);
+
+    assert(segarray_set(arr, 0, &b) == true);
+    assert(*first == &b);
+    assert(segarray_set(arr, SEGARRAY_CHUNK_SIZE * 4 + 1, &b) == false);
+
+    segarray_destroy(arr);
+    printf("PASSED\n");
+}
+
+static void test_sa_pop_releases_chunks(void)
+{
+    printf("Test: SA pop releases chunks... ");
+    segmented_array_t *arr = segarray_init();
+
+    assert(segarray_pop(arr) == NULL);
+
+    int values[3] = {0, 1, 2};
+    for (size_t i = 0; i < SEGARRAY_CHUNK_SIZE * 3; i++)
+    {
+        segarray_push(arr, &values[i % 3]);
+    }
+    assert(arr->chunk_count == 3);
+
+    while (segarray_size(arr) > 1)
+    {
+        segarray_pop(arr);
+    }
+    assert(arr->chunk_count == 2);
+    assert(*(int *) segarray_pop(arr) == 0);
+    assert(segarray_is_empty(arr) == true);
+    assert(arr->chunk_count == 1);
+
+    segarray_destroy(arr);
+    printf("PASSED\n");
+}
+
+/* ============================================
+ *              DEQUE TESTS
+ * ============================================ */
+
+static void test_dq_push_pop_both_ends(void)
+{
+    printf("Test: DQ push and pop at both ends... ");
+    deque_t *deque = deque_init();
+
+    int values[4] = {1, 2, 3, 4};
+    deque_push_back(deque, &values[2]);
+    deque_push_front(deque, &values[1]);
+    deque_push_back(deque, &values[3]);
+    deque_push_front(deque, &values[0]);
+
+    assert(deque_size(deque) == 4);
+    for (int i = 0; i < 4; i++)
+    {
+        assert(*(int *) deque_get(deque, (size_t) i) == i + 1);
+    }
+    assert(*(int *) deque_pop_front(deque) == 1);
+    assert(*(int *) deque_pop_back(deque) == 4);
+    assert(*(int *) deque_pop_back(deque) == 3);
+    assert(*(int *) deque_pop_front(deque) == 2);
+    assert(deque_is_empty(deque) == true);
+    assert(deque_pop_front(deque) == NULL);
+    assert(deque_pop_back(deque) == NULL);
+
+    deque_destroy(deque);
+    printf("PASSED\n");
+}
+
+static void test_dq_growth_while_wrapped(void)
+{
+    printf("Test: DQ growth keeps order when wrapped... ");
+    deque_t *deque = deque_init();
+
+    int values[100];
+    for (int i = 0; i < 100; i++)
+    {
+        values[i] = i;
+    }
+    // Alternate ends so the live range wraps around before each growth
+    for (int i = 49; i >= 0; i--)
+    {
+        assert(deque_push_front(deque, &values[i]) == true);
+        assert(deque_push_back(deque, &values[99 - i]) == true);
+    }
+
+    assert(deque_size(deque) == 100);
+    for (int i = 0; i < 100; i++)
+    {
+        assert(*(int *) deque_get(deque, (size_t) i) == i);
+    }
+    assert(deque_get(deque, 100) == NULL);
+
+    deque_destroy(deque);
+    printf("PASSED\n");
+}
+
+static void test_dq_queue_churn(void)
+{
+    printf("Test: DQ FIFO churn wraps without growing... ");
+    deque_t *deque = deque_init();
+
+    int value = 7;
+    for (int i = 0; i < 1000; i++)
+    {
+        deque_push_back(deque, &value);
+        deque_push_back(deque, &value);
+        deque_pop_front(deque);
+        deque_pop_front(deque);
+    }
+    assert(deque_is_empty(deque) == true);
+    assert(deque->capacity == DEQUE_INITIAL_CAPACITY);
+
+    deque_push_back(deque, &value);
+    assert(deque_set(deque, 0, NULL) == true);
+    assert(deque_set(deque, 1, NULL) == false);
+    assert(deque_get(deque, 0) == NULL);
+
+    deque_destroy(deque);
+    printf("PASSED\n");
+}
+
 /* ============================================
  *          LINKED LIST TESTS
  * ============================================ */
@@ -1045,20 +1596,1684 @@ static void test_ll_insert_then_remove(void)
     printf("PASSED\n");
 }
 
-/* ============================================
- *               MAIN
- * ============================================ */
-
-int main(void)
+static void test_ll_get_element_from_tail_side(void)
 {
-    printf("\n========================================\n");
-    printf("         DYNAMIC ARRAY TESTS\n");
-    printf("========================================\n\n");
+    printf("Test: LL indexed access near the tail... ");
+    linked_list_t *list = init_linkedlist();
 
-    test_da_init_and_destroy();
-    test_da_push_single();
-    test_da_push_and_get();
-    test_da_pop();
+    for (int i = 0; i < 1000; i++)
+    {
+        push_node(list, make_int(i));
+    }
+    assert(*(int *) get_element(list, 998) == 998);
+    insert_node(list, 990, make_int(-1));
+    assert(*(int *) get_element(list, 990) == -1);
+    assert(*(int *) get_element(list, 991) == 990);
+    remove_node(list, 990);
+    assert(*(int *) get_element(list, 990) == 990);
+    assert(*(int *) rec_get_element(list->head, 500) == 500);
+
+    delete_linkedlist(list);
+    printf("PASSED\n");
+}
+
+static void test_ll_cursor_walk(void)
+{
+    printf("Test: LL cursor walks both ways... ");
+    linked_list_t *list = init_linkedlist();
+
+    for (int i = 0; i < 5; i++)
+    {
+        push_node(list, make_int(i));
+    }
+
+    int expected = 0;
+    for (list_cursor_t c = list_cursor_front(list); list_cursor_valid(&c); list_cursor_next(&c))
+    {
+        assert(list_cursor_index(&c) == (size_t) expected);
+        assert(*(int *) list_cursor_get(&c) == expected++);
+    }
+
+    list_cursor_t c = list_cursor_back(list);
+    assert(*(int *) list_cursor_get(&c) == 4);
+    list_cursor_next(&c);
+    assert(list_cursor_valid(&c) == false);
+    assert(list_cursor_index(&c) == 5);
+    list_cursor_next(&c);
+    assert(*(int *) list_cursor_get(&c) == 0);
+    list_cursor_prev(&c);
+    list_cursor_prev(&c);
+    assert(*(int *) list_cursor_get(&c) == 4);
+
+    c = list_cursor_at(list, 3);
+    assert(*(int *) list_cursor_get(&c) == 3);
+
+    delete_linkedlist(list);
+    printf("PASSED\n");
+}
+
+static void test_ll_cursor_edit(void)
+{
+    printf("Test: LL cursor insert and remove... ");
+    linked_list_t *list = init_linkedlist();
+
+    list_cursor_t c = list_cursor_front(list);
+    list_cursor_insert_before(&c, make_int(3));
+    list_cursor_insert_after(&c, make_int(1));
+    assert(get_linked_list_size(list) == 2);
+
+    c = list_cursor_front(list);
+    list_cursor_insert_after(&c, make_int(2));
+    list_cursor_insert_before(&c, make_int(0));
+    assert(list_cursor_index(&c) == 1);
+
+    for (int i = 0; i < 4; i++)
+    {
+        assert(*(int *) get_element(list, (size_t) i) == i);
+    }
+
+    // Drop the odd values in one pass
+    c = list_cursor_front(list);
+    while (list_cursor_valid(&c))
+    {
+        if (*(int *) list_cursor_get(&c) % 2 != 0)
+        {
+            free(list_cursor_remove(&c));
+            continue;
+        }
+        list_cursor_next(&c);
+    }
+    assert(get_linked_list_size(list) == 2);
+    assert(*(int *) get_element(list, 1) == 2);
+    assert(*(int *) list->tail->value == 2);
+
+    delete_linkedlist(list);
+    printf("PASSED\n");
+}
+
+static void test_ll_sort_stable(void)
+{
+    printf("Test: LL sort is stable and relinks prev... ");
+    linked_list_t *list = init_linkedlist();
+
+    int input[]  = {52, 11, 53, 10, 99, 31, 12, 30, 51, 0, 13};
+    int sorted[] = {0, 11, 10, 12, 13, 31, 30, 52, 53, 51, 99};
+    for (size_t i = 0; i < sizeof(input) / sizeof(input[0]); i++)
+    {
+        push_node(list, make_int(input[i]));
+    }
+    list_sort(list, cmp_tens);
+
+    size_t i = 0;
+    for (list_cursor_t c = list_cursor_front(list); list_cursor_valid(&c); list_cursor_next(&c))
+    {
+        assert(*(int *) list_cursor_get(&c) == sorted[i++]);
+    }
+    // Walk back through prev to check the links were rebuilt
+    for (list_cursor_t c = list_cursor_back(list); list_cursor_valid(&c); list_cursor_prev(&c))
+    {
+        assert(*(int *) list_cursor_get(&c) == sorted[--i]);
+    }
+    assert(i == 0);
+
+    delete_linkedlist(list);
+    printf("PASSED\n");
+}
+
+static void test_ll_sort_large(void)
+{
+    printf("Test: LL sort 10000 values... ");
+    linked_list_t *list  = init_linkedlist();
+    unsigned       state = 7;
+
+    for (int i = 0; i < 10000; i++)
+    {
+        state = state * 1103515245U + 12345U;
+        push_node(list, make_int((int) (state >> 16U)));
+    }
+    list_sort(list, cmp_int);
+
+    assert(get_linked_list_size(list) == 10000);
+    for (node_t *node = list->head; node->next != NULL; node = node->next)
+    {
+        assert(cmp_int(node->value, ((node_t *) node->next)->value) <= 0);
+    }
+
+    delete_linkedlist(list);
+    printf("PASSED\n");
+}
+
+static void test_ll_merge(void)
+{
+    printf("Test: LL merge two sorted lists... ");
+    linked_list_t *dst = init_linkedlist();
+    linked_list_t *src = init_linkedlist();
+
+    for (int i = 0; i < 10; i += 2)
+    {
+        push_node(dst, make_int(i));
+        push_node(src, make_int(i + 1));
+    }
+    list_merge(dst, src, cmp_int);
+
+    assert(get_linked_list_size(dst) == 10);
+    assert(get_linked_list_size(src) == 0);
+    for (int i = 0; i < 10; i++)
+    {
+        assert(*(int *) get_element(dst, (size_t) i) == i);
+    }
+    assert(*(int *) dst->tail->value == 9);
+
+    delete_linkedlist(src);
+    delete_linkedlist(dst);
+    printf("PASSED\n");
+}
+
+static void test_ll_splice_split(void)
+{
+    printf("Test: LL splice and split... ");
+    linked_list_t *list  = init_linkedlist();
+    linked_list_t *other = init_linkedlist();
+
+    push_node(list, make_int(0));
+    push_node(list, make_int(3));
+    push_node(other, make_int(1));
+    push_node(other, make_int(2));
+
+    list_cursor_t c = list_cursor_at(list, 1);
+    list_splice(&c, other);
+    assert(get_linked_list_size(list) == 4);
+    assert(get_linked_list_size(other) == 0);
+    assert(list_cursor_index(&c) == 3);
+    for (int i = 0; i < 4; i++)
+    {
+        assert(*(int *) get_element(list, (size_t) i) == i);
+    }
+
+    c                   = list_cursor_at(list, 2);
+    linked_list_t *rest = list_split(&c);
+    assert(get_linked_list_size(list) == 2);
+    assert(get_linked_list_size(rest) == 2);
+    assert(*(int *) list->tail->value == 1);
+    assert(*(int *) get_element(rest, 0) == 2);
+    assert(c.list == rest);
+
+    // Splicing at the end position appends
+    c = list_cursor_at(list, get_linked_list_size(list));
+    list_splice(&c, rest);
+    assert(*(int *) list->tail->value == 3);
+    assert(get_linked_list_size(list) == 4);
+
+    delete_linkedlist(rest);
+    delete_linkedlist(other);
+    delete_linkedlist(list);
+    printf("PASSED\n");
+}
+
+/* ============================================
+ *          COMPACT LIST TESTS
+ * ============================================ */
+
+static void test_cl_operations(void)
+{
+    printf("Test: CL push, insert, remove, pop... ");
+    compact_list_t *list = clist_init();
+
+    for (int i = 0; i < 40; i += 2)
+    {
+        clist_push_node(list, make_int(i));
+    }
+    for (int i = 1; i < 40; i += 2)
+    {
+        clist_insert_node(list, (size_t) i, make_int(i));
+    }
+    assert(clist_size(list) == 40);
+    for (int i = 0; i < 40; i++)
+    {
+        assert(*(int *) clist_get_element(list, (size_t) i) == i);
+    }
+
+    clist_remove_node(list, 39);
+    clist_remove_node(list, 10);
+    int *head = (int *) clist_pop_head(list);
+    int *tail = (int *) clist_pop_tail(list);
+    assert(*head == 0);
+    assert(*tail == 38);
+    assert(clist_size(list) == 36);
+    assert(*(int *) clist_get_element(list, 9) == 11);
+
+    free(head);
+    free(tail);
+    clist_delete(list);
+    printf("PASSED\n");
+}
+
+static void test_cl_slot_reuse(void)
+{
+    printf("Test: CL removed slots are reused... ");
+    compact_list_t *list = clist_init();
+
+    for (int i = 0; i < 16; i++)
+    {
+        clist_push_node(list, make_int(i));
+    }
+    u32_t capacity = list->capacity;
+    for (int i = 0; i < 100; i++)
+    {
+        free(clist_pop_head(list));
+        clist_push_node(list, make_int(i));
+    }
+    assert(list->capacity == capacity);
+    assert(list->used == 16);
+    assert(*(int *) clist_get_element(list, 15) == 99);
+
+    clist_delete(list);
+    printf("PASSED\n");
+}
+
+static void test_cl_clone(void)
+{
+    printf("Test: CL clone copies the arena... ");
+    compact_list_t *list = clist_init();
+
+    for (int i = 0; i < 50; i++)
+    {
+        clist_insert_node(list, 0, make_int(i));
+    }
+    compact_list_t *clone = clist_clone(list);
+    // Values are shared, pop instead of remove so the clone keeps a live value
+    assert(*(int *) clist_pop_head(list) == 49);
+
+    assert(clist_size(clone) == 50);
+    assert(clist_size(list) == 49);
+    for (int i = 0; i < 50; i++)
+    {
+        assert(*(int *) clist_get_element(clone, (size_t) i) == 49 - i);
+    }
+
+    clist_delete_shallow(list);
+    clist_delete(clone);
+    printf("PASSED\n");
+}
+
+/* ============================================
+ *          UNROLLED LIST TESTS
+ * ============================================ */
+
+static void test_ul_push_get_pop(void)
+{
+    printf("Test: UL push, get and pop across nodes... ");
+    unrolled_list_t *list = ulist_init();
+
+    for (int i = 0; i < 100; i++)
+    {
+        ulist_push_node(list, make_int(i));
+    }
+    assert(ulist_size(list) == 100);
+    for (int i = 0; i < 100; i++)
+    {
+        assert(*(int *) ulist_get_element(list, (size_t) i) == i);
+    }
+
+    int *head = (int *) ulist_pop_head(list);
+    int *tail = (int *) ulist_pop_tail(list);
+    assert(*head == 0);
+    assert(*tail == 99);
+    assert(ulist_size(list) == 98);
+    assert(*(int *) ulist_get_element(list, 0) == 1);
+
+    free(head);
+    free(tail);
+    ulist_delete(list);
+    printf("PASSED\n");
+}
+
+static void test_ul_insert_splits(void)
+{
+    printf("Test: UL insert into full nodes splits them... ");
+    unrolled_list_t *list = ulist_init();
+
+    // Build 0..199 by inserting every odd number between the evens
+    for (int i = 0; i < 100; i++)
+    {
+        ulist_push_node(list, make_int(i * 2));
+    }
+    for (int i = 0; i < 100; i++)
+    {
+        ulist_insert_node(list, (size_t) (i * 2 + 1), make_int(i * 2 + 1));
+    }
+    ulist_insert_node(list, 0, make_int(-1));
+
+    assert(ulist_size(list) == 201);
+    for (int i = 0; i < 201; i++)
+    {
+        assert(*(int *) ulist_get_element(list, (size_t) i) == i - 1);
+    }
+
+    ulist_delete(list);
+    printf("PASSED\n");
+}
+
+static void test_ul_remove_merges(void)
+{
+    printf("Test: UL remove merges sparse nodes... ");
+    unrolled_list_t *list = ulist_init();
+
+    for (int i = 0; i < 10 * ULIST_NODE_CAPACITY; i++)
+    {
+        ulist_push_node(list, make_int(i));
+    }
+    // Keep only the multiples of 10
+    for (int i = 10 * ULIST_NODE_CAPACITY - 1; i >= 0; i--)
+    {
+        if (i % 10 != 0)
+        {
+            ulist_remove_node(list, (size_t) i);
+        }
+    }
+
+    assert(ulist_size(list) == ULIST_NODE_CAPACITY);
+    size_t nodes = 0;
+    for (unode_t *node = list->head; node != NULL; node = node->next)
+    {
+        nodes++;
+    }
+    assert(nodes <= 2);
+    for (int i = 0; i < ULIST_NODE_CAPACITY; i++)
+    {
+        assert(*(int *) ulist_get_element(list, (size_t) i) == i * 10);
+    }
+
+    while (ulist_size(list) > 0)
+    {
+        ulist_remove_node(list, 0);
+    }
+    assert(list->head == NULL);
+    assert(list->tail == NULL);
+
+    ulist_delete(list);
+    printf("PASSED\n");
+}
+
+/* ============================================
+ *            SKIP LIST TESTS
+ * ============================================ */
+
+static void test_sl_push_get_pop(void)
+{
+    printf("Test: SL push, get and pop... ");
+    skip_list_t *list = skiplist_init();
+
+    for (int i = 0; i < 500; i++)
+    {
+        skiplist_push_node(list, make_int(i));
+    }
+    assert(skiplist_size(list) == 500);
+    for (int i = 0; i < 500; i++)
+    {
+        assert(*(int *) skiplist_get_element(list, (size_t) i) == i);
+    }
+
+    int *head = (int *) skiplist_pop_head(list);
+    int *tail = (int *) skiplist_pop_tail(list);
+    assert(*head == 0);
+    assert(*tail == 499);
+    assert(*(int *) skiplist_get_element(list, 0) == 1);
+    assert(*(int *) skiplist_get_element(list, 497) == 498);
+
+    free(head);
+    free(tail);
+    skiplist_delete(list);
+    printf("PASSED\n");
+}
+
+static void test_sl_insert_remove_match_array(void)
+{
+    printf("Test: SL random inserts and removes match an array... ");
+    skip_list_t *list = skiplist_init();
+    int          mirror[600];
+    size_t       len   = 0;
+    unsigned     state = 12345;
+
+    for (int i = 0; i < 600; i++)
+    {
+        state        = state * 1103515245U + 12345U;
+        size_t index = (size_t) (state >> 16U) % (len + 1);
+        memmove(&mirror[index + 1], &mirror[index], (len - index) * sizeof(int));
+        mirror[index] = i;
+        len++;
+        skiplist_insert_node(list, index, make_int(i));
+    }
+    for (int i = 0; i < 300; i++)
+    {
+        state        = state * 1103515245U + 12345U;
+        size_t index = (size_t) (state >> 16U) % len;
+        memmove(&mirror[index], &mirror[index + 1], (len - index - 1) * sizeof(int));
+        len--;
+        skiplist_remove_node(list, index);
+    }
+
+    assert(skiplist_size(list) == len);
+    for (size_t i = 0; i < len; i++)
+    {
+        assert(*(int *) skiplist_get_element(list, i) == mirror[i]);
+    }
+
+    skiplist_delete(list);
+    printf("PASSED\n");
+}
+
+static void test_sl_drain(void)
+{
+    printf("Test: SL drain and reuse... ");
+    skip_list_t *list = skiplist_init();
+
+    for (int i = 0; i < 100; i++)
+    {
+        skiplist_insert_node(list, 0, make_int(i));
+    }
+    while (skiplist_size(list) > 0)
+    {
+        skiplist_remove_node(list, skiplist_size(list) / 2);
+    }
+    assert(list->level == 1);
+
+    skiplist_insert_node(list, 0, make_int(7));
+    assert(*(int *) skiplist_get_element(list, 0) == 7);
+
+    skiplist_delete(list);
+    printf("PASSED\n");
+}
+
+/* ============================================
+ *          INTRUSIVE LIST TESTS
+ * ============================================ */
+
+static int job_id(ilist_link_t *link)
+{
+    return ILIST_CONTAINER_OF(link, job_t, queue_link)->id;
+}
+
+static void test_il_push_pop_container_of(void)
+{
+    printf("Test: IL push, pop and container_of... ");
+    intrusive_list_t queue;
+    ilist_init(&queue);
+
+    job_t jobs[3] = {{.id = 1}, {.id = 2}, {.id = 3}};
+    ilist_push_tail(&queue, &jobs[1].queue_link);
+    ilist_push_head(&queue, &jobs[0].queue_link);
+    ilist_push_tail(&queue, &jobs[2].queue_link);
+
+    assert(ilist_size(&queue) == 3);
+    assert(job_id(ilist_get(&queue, 0)) == 1);
+    assert(job_id(ilist_get(&queue, 2)) == 3);
+    assert(ilist_get(&queue, 3) == NULL);
+
+    assert(ILIST_CONTAINER_OF(ilist_pop_head(&queue), job_t, queue_link) == &jobs[0]);
+    assert(ILIST_CONTAINER_OF(ilist_pop_tail(&queue), job_t, queue_link) == &jobs[2]);
+    assert(ilist_pop_tail(&queue) == &jobs[1].queue_link);
+    assert(ilist_is_empty(&queue) == true);
+    assert(ilist_pop_head(&queue) == NULL);
+    printf("PASSED\n");
+}
+
+static void test_il_object_on_two_lists(void)
+{
+    printf("Test: IL one object on two lists... ");
+    intrusive_list_t queue;
+    intrusive_list_t owned;
+    ilist_init(&queue);
+    ilist_init(&owned);
+
+    job_t jobs[4];
+    for (int i = 0; i < 4; i++)
+    {
+        jobs[i].id = i;
+        ilist_push_tail(&queue, &jobs[i].queue_link);
+        if (i % 2 == 0)
+        {
+            ilist_push_head(&owned, &jobs[i].owner_link);
+        }
+    }
+
+    // Removing from one list leaves the other intact
+    ilist_remove(&queue, &jobs[2].queue_link);
+    assert(ilist_size(&queue) == 3);
+    assert(job_id(ilist_get(&queue, 2)) == 3);
+    assert(ILIST_CONTAINER_OF(owned.head, job_t, owner_link)->id == 2);
+
+    ilist_insert_after(&queue, &jobs[1].queue_link, &jobs[2].queue_link);
+    for (int i = 0; i < 4; i++)
+    {
+        assert(job_id(ilist_get(&queue, (size_t) i)) == i);
+    }
+    assert(ilist_size(&owned) == 2);
+    assert(ILIST_CONTAINER_OF(owned.tail, job_t, owner_link) == &jobs[0]);
+    printf("PASSED\n");
+}
+
+/* ============================================
+ *          POOL ALLOCATOR TESTS
+ * ============================================ */
+
+static void test_pool_alloc_reuse(void)
+{
+    printf("Test: POOL freed objects are reused first... ");
+    pool_t *pool = pool_init(sizeof(node_t), 4);
+
+    void *a = pool_alloc(pool);
+    void *b = pool_alloc(pool);
+    assert(a != b);
+    assert(pool_live(pool) == 2);
+
+    pool_free(pool, a);
+    assert(pool_live(pool) == 1);
+    assert(pool_alloc(pool) == a);
+
+    // Crossing the slab boundary allocates a second slab
+    for (int i = 0; i < 10; i++)
+    {
+        assert(pool_alloc(pool) != NULL);
+    }
+    assert(pool_live(pool) == 12);
+    assert(pool->slabs->next != NULL);
+
+    pool_destroy(pool);
+    printf("PASSED\n");
+}
+
+static void test_ll_pooled_private(void)
+{
+    printf("Test: LL with a private node pool... ");
+    linked_list_t *list = init_linkedlist_pooled(NULL);
+
+    for (int i = 0; i < 1000; i++)
+    {
+        push_node(list, make_int(i));
+    }
+    insert_node(list, 500, make_int(-1));
+    remove_node(list, 500);
+    free(pop_head(list));
+    free(pop_tail(list));
+
+    assert(get_linked_list_size(list) == 998);
+    assert(pool_live(list->pool) == 998);
+    assert(*(int *) get_element(list, 0) == 1);
+    assert(*(int *) get_element(list, 997) == 998);
+
+    delete_linkedlist(list);
+    printf("PASSED\n");
+}
+
+static void test_ll_pooled_shared(void)
+{
+    printf("Test: LL lists sharing one node pool... ");
+    pool_t        *pool  = pool_init(sizeof(node_t), 0);
+    linked_list_t *first = init_linkedlist_pooled(pool);
+    linked_list_t *other = init_linkedlist_pooled(pool);
+
+    push_node(first, make_int(1));
+    push_node(other, make_int(2));
+    push_node(first, make_int(3));
+    assert(pool_live(pool) == 3);
+
+    delete_linkedlist(first);
+    assert(pool_live(pool) == 1);
+    assert(*(int *) get_element(other, 0) == 2);
+
+    delete_linkedlist(other);
+    assert(pool_live(pool) == 0);
+    pool_destroy(pool);
+    printf("PASSED\n");
+}
+
+/* ============================================
+ *            HASH MAP TESTS
+ * ============================================ */
+
+static void sum_visit(u32_t key, void *data, void *ctx)
+{
+    assert((u32_t) *(int *) data == key * 2);
+    *(long *) ctx += *(int *) data;
+}
+
+static void test_hm_sc_operations(void)
+{
+    printf("Test: HM separate chaining put/get/remove/grow... ");
+    hash_map_sc_t *map = init_hash_map();
+
+    for (int i = 0; i < 1000; i++)
+    {
+        add_entry_sc(map, (u32_t) i, make_int(i * 2));
+    }
+    assert(map->size == 1000);
+    assert(map->load_factor <= HASH_MAP_THRESHOLD);
+    for (int i = 0; i < 1000; i++)
+    {
+        assert(*(int *) get_entry_sc(map, (u32_t) i) == i * 2);
+    }
+    assert(get_entry_sc(map, 5000) == NULL);
+
+    // Replacing frees the old data, the size does not change
+    add_entry_sc(map, 7, make_int(14));
+    assert(map->size == 1000);
+
+    for (int i = 0; i < 1000; i += 2)
+    {
+        assert(remove_entry_sc(map, (u32_t) i));
+    }
+    assert(!remove_entry_sc(map, 0));
+    assert(map->size == 500);
+    assert(get_entry_sc(map, 4) == NULL);
+    assert(*(int *) get_entry_sc(map, 5) == 10);
+
+    long sum = 0;
+    for_each_entry_sc(map, sum_visit, &sum);
+    assert(sum == 500L * 1000L);
+
+    delete_hash_map_sc(map);
+    printf("PASSED\n");
+}
+
+static void test_hm_sc_incremental_rehash(void)
+{
+    printf("Test: HM separate chaining migrates buckets a few at a time... ");
+    hash_map_sc_t *map        = init_hash_map();
+    size_t         migrations = 0;
+
+    for (int i = 0; i < 5000; i++)
+    {
+        add_entry_sc(map, (u32_t) i, make_int(i * 2));
+        migrations += map->old_buckets != NULL;
+        // Every key stays reachable whichever table currently holds it
+        assert(*(int *) get_entry_sc(map, (u32_t) (i / 2)) == i / 2 * 2);
+        if (map->old_buckets != NULL && i % 3 == 0)
+        {
+            assert(remove_entry_sc(map, (u32_t) i));
+            add_entry_sc(map, (u32_t) i, make_int(i * 2));
+        }
+    }
+    assert(migrations > 0);
+    assert(map->size == 5000);
+
+    long sum = 0;
+    for_each_entry_sc(map, sum_visit, &sum);
+    assert(sum == 4999L * 5000L);
+
+    load_value_sc(map);
+    assert(map->old_buckets == NULL);
+    for (int i = 0; i < 5000; i++)
+    {
+        assert(*(int *) get_entry_sc(map, (u32_t) i) == i * 2);
+    }
+
+    delete_hash_map_sc(map);
+    printf("PASSED\n");
+}
+
+static void test_hm_oa_operations(void)
+{
+    printf("Test: HM open addressing put/get/remove/grow... ");
+    hash_map_oa_t *map = init_hash_map_oa();
+
+    for (int i = 0; i < 1000; i++)
+    {
+        add_entry_oa(map, (u32_t) i, make_int(i * 2));
+    }
+    assert(map->size == 1000);
+    assert(map->load_factor <= HASH_MAP_THRESHOLD);
+    for (int i = 0; i < 1000; i++)
+    {
+        assert(*(int *) get_entry_oa(map, (u32_t) i) == i * 2);
+    }
+    assert(get_entry_oa(map, 5000) == NULL);
+
+    add_entry_oa(map, 7, make_int(14));
+    assert(map->size == 1000);
+
+    for (int i = 0; i < 1000; i += 2)
+    {
+        assert(remove_entry_oa(map, (u32_t) i));
+    }
+    assert(!remove_entry_oa(map, 0));
+    assert(map->size == 500);
+
+    long sum = 0;
+    for_each_entry_oa(map, sum_visit, &sum);
+    assert(sum == 500L * 1000L);
+
+    delete_hash_map_oa(map);
+    printf("PASSED\n");
+}
+
+static void test_hm_oa_backward_shift(void)
+{
+    printf("Test: HM open addressing keeps probe runs intact after removals... ");
+    hash_map_oa_t *map = init_hash_map_oa();
+
+    // Interleave inserts and removals so runs wrap and shift repeatedly
+    for (int round = 0; round < 20; round++)
+    {
+        for (int i = 0; i < 200; i++)
+        {
+            add_entry_oa(map, (u32_t) (round * 200 + i), make_int(round * 200 + i));
+        }
+        for (int i = 0; i < 200; i += 3)
+        {
+            assert(remove_entry_oa(map, (u32_t) (round * 200 + i)));
+        }
+    }
+    for (int key = 0; key < 4000; key++)
+    {
+        int *value = get_entry_oa(map, (u32_t) key);
+        if (key % 200 % 3 == 0)
+        {
+            assert(value == NULL);
+        }
+        else
+        {
+            assert(value != NULL && *value == key);
+        }
+    }
+    for (size_t i = 0; i < map->capacity; i++)
+    {
+        assert(map->slots[i].dist == 0 || map->slots[i].data != NULL);
+    }
+
+    delete_hash_map_oa(map);
+    printf("PASSED\n");
+}
+
+static void test_hm_simd_operations(void)
+{
+    printf("Test: HM control bytes put/get/remove/grow... ");
+    hash_map_simd_t *map = init_hash_map_simd();
+
+    for (int i = 0; i < 1000; i++)
+    {
+        add_entry_simd(map, (u32_t) i, make_int(i * 2));
+    }
+    assert(map->size == 1000);
+    assert(map->load_factor <= HASH_MAP_SIMD_THRESHOLD);
+    for (int i = 0; i < 1000; i++)
+    {
+        assert(*(int *) get_entry_simd(map, (u32_t) i) == i * 2);
+    }
+    assert(get_entry_simd(map, 5000) == NULL);
+
+    add_entry_simd(map, 7, make_int(14));
+    assert(map->size == 1000);
+
+    for (int i = 0; i < 1000; i += 2)
+    {
+        assert(remove_entry_simd(map, (u32_t) i));
+    }
+    assert(!remove_entry_simd(map, 0));
+    assert(map->size == 500);
+    assert(get_entry_simd(map, 4) == NULL);
+
+    long sum = 0;
+    for_each_entry_simd(map, sum_visit, &sum);
+    assert(sum == 500L * 1000L);
+
+    delete_hash_map_simd(map);
+    printf("PASSED\n");
+}
+
+static void test_hm_simd_tombstone_churn(void)
+{
+    printf("Test: HM control bytes reuse tombstones without growing... ");
+    hash_map_simd_t *map = init_hash_map_simd();
+
+    // A sliding window of 8 live keys: deletes leave tombstones that rehashes must purge
+    for (int i = 0; i < 10000; i++)
+    {
+        add_entry_simd(map, (u32_t) i, make_int(i));
+        if (i >= 8)
+        {
+            assert(remove_entry_simd(map, (u32_t) (i - 8)));
+        }
+    }
+    assert(map->size == 8);
+    assert(map->capacity <= 64);
+    for (int i = 9992; i < 10000; i++)
+    {
+        assert(*(int *) get_entry_simd(map, (u32_t) i) == i);
+    }
+    assert(get_entry_simd(map, 9991) == NULL);
+
+    delete_hash_map_simd(map);
+    printf("PASSED\n");
+}
+
+#define BATCH_KEYS 1007 // Not a multiple of HASH_MAP_BATCH
+
+static void test_hm_fc_operations(void)
+{
+    printf("Test: HM flat chaining put/get/remove/grow... ");
+    hash_map_fc_t *map = init_hash_map_fc();
+
+    for (int i = 0; i < 1000; i++)
+    {
+        add_entry_fc(map, (u32_t) i, make_int(i * 2));
+    }
+    assert(map->size == 1000);
+    assert(map->load_factor <= HASH_MAP_THRESHOLD);
+    for (int i = 0; i < 1000; i++)
+    {
+        assert(*(int *) get_entry_fc(map, (u32_t) i) == i * 2);
+    }
+    assert(get_entry_fc(map, 5000) == NULL);
+
+    add_entry_fc(map, 7, make_int(14));
+    assert(map->size == 1000);
+
+    for (int i = 0; i < 1000; i += 2)
+    {
+        assert(remove_entry_fc(map, (u32_t) i));
+    }
+    assert(!remove_entry_fc(map, 0));
+    assert(map->size == 500);
+    assert(get_entry_fc(map, 4) == NULL);
+
+    long sum = 0;
+    for_each_entry_fc(map, sum_visit, &sum);
+    assert(sum == 500L * 1000L);
+
+    delete_hash_map_fc(map);
+    printf("PASSED\n");
+}
+
+static void test_hm_fc_chains(void)
+{
+    printf("Test: HM flat chaining promotes overflow entries and reuses them... ");
+    hash_map_fc_t *map = init_hash_map_fc();
+
+    // 12 keys in 16 buckets collide for sure, removing every head exercises the promotion
+    for (int i = 0; i < 12; i++)
+    {
+        add_entry_fc(map, (u32_t) i * 1000U, make_int(i));
+    }
+    size_t overflow = map->overflow_used;
+    assert(overflow > 0);
+    for (int i = 0; i < 12; i++)
+    {
+        assert(remove_entry_fc(map, (u32_t) i * 1000U));
+        for (int j = i + 1; j < 12; j++)
+        {
+            assert(*(int *) get_entry_fc(map, (u32_t) j * 1000U) == j);
+        }
+    }
+    assert(map->size == 0);
+
+    // Same keys again: released overflow entries are reused before the array grows
+    for (int i = 0; i < 12; i++)
+    {
+        add_entry_fc(map, (u32_t) i * 1000U, make_int(i));
+    }
+    assert(map->overflow_used == overflow);
+
+    delete_hash_map_fc(map);
+    printf("PASSED\n");
+}
+
+static void collect_keys_visit(u32_t key, void *data, void *ctx)
+{
+    (void) data;
+    int_array_push(ctx, (int) key);
+}
+
+static void test_hm_dense_operations(void)
+{
+    printf("Test: HM dense put/get/remove/grow and index widths... ");
+    hash_map_dense_t *map = init_hash_map_dense();
+    assert(map->index_width == 1);
+
+    for (int i = 0; i < 100000; i++)
+    {
+        add_entry_dense(map, (u32_t) i, make_int(i * 2));
+        if (i == 1000)
+        {
+            assert(map->index_width == 2);
+        }
+    }
+    assert(map->index_width == 4);
+    assert(map->size == 100000);
+    assert(map->load_factor <= HASH_MAP_THRESHOLD);
+    for (int i = 0; i < 100000; i += 7)
+    {
+        assert(*(int *) get_entry_dense(map, (u32_t) i) == i * 2);
+    }
+    assert(get_entry_dense(map, 200000) == NULL);
+
+    for (int i = 0; i < 100000; i += 2)
+    {
+        assert(remove_entry_dense(map, (u32_t) i));
+    }
+    assert(!remove_entry_dense(map, 0));
+    assert(map->size == 50000);
+
+    long sum = 0;
+    for_each_entry_dense(map, sum_visit, &sum);
+    assert(sum == 50000L * 100000L);
+
+    delete_hash_map_dense(map);
+    printf("PASSED\n");
+}
+
+static void test_hm_dense_order(void)
+{
+    printf("Test: HM dense iterates in insertion order and compacts... ");
+    hash_map_dense_t *map    = init_hash_map_dense();
+    int_array_t      *seen   = int_array_init();
+    const u32_t       keys[] = {42, 7, 1000, 3, 99, 5};
+
+    for (size_t i = 0; i < 6; i++)
+    {
+        add_entry_dense(map, keys[i], make_int((int) keys[i]));
+    }
+    assert(remove_entry_dense(map, 1000));
+    add_entry_dense(map, 7, make_int(7));
+    add_entry_dense(map, 1000, make_int(1000));
+
+    // Replacing 7 keeps its place, re-adding 1000 appends it
+    for_each_entry_dense(map, collect_keys_visit, seen);
+    const int expected[] = {42, 7, 3, 99, 5, 1000};
+    assert(int_array_size(seen) == 6);
+    for (size_t i = 0; i < 6; i++)
+    {
+        assert(*int_array_get(seen, i) == expected[i]);
+    }
+
+    const dense_entry_t *entries = entries_dense(map);
+    assert(map->used == map->size);
+    for (size_t i = 0; i < 6; i++)
+    {
+        assert(entries[i].key == (u32_t) expected[i]);
+        assert(*(int *) entries[i].data == expected[i]);
+    }
+    assert(*(int *) get_entry_dense(map, 1000) == 1000);
+
+    int_array_destroy(seen);
+    delete_hash_map_dense(map);
+    printf("PASSED\n");
+}
+
+static void test_hm_dense_churn(void)
+{
+    printf("Test: HM dense reclaims removed entries without growing... ");
+    hash_map_dense_t *map = init_hash_map_dense();
+    for (int i = 0; i < 10000; i++)
+    {
+        add_entry_dense(map, (u32_t) i, make_int(i));
+        if (i >= 4)
+        {
+            assert(remove_entry_dense(map, (u32_t) (i - 4)));
+        }
+    }
+    assert(map->size == 4);
+    assert(map->index_capacity == HASH_MAP_INITIAL_CAPACITY);
+    assert(*(int *) get_entry_dense(map, 9999) == 9999);
+    delete_hash_map_dense(map);
+    printf("PASSED\n");
+}
+
+static void test_hm_batches(void)
+{
+    printf("Test: HM batched put/get match single calls... ");
+    hash_map_sc_t *sc = init_hash_map();
+    hash_map_oa_t *oa = init_hash_map_oa();
+    u32_t          keys[BATCH_KEYS];
+    void          *sc_data[BATCH_KEYS];
+    void          *oa_data[BATCH_KEYS];
+    void          *out[BATCH_KEYS];
+
+    for (int i = 0; i < BATCH_KEYS; i++)
+    {
+        keys[i]    = (u32_t) i * 7U;
+        sc_data[i] = make_int(i);
+        oa_data[i] = make_int(i);
+    }
+    add_batch_sc(sc, keys, sc_data, BATCH_KEYS);
+    add_batch_oa(oa, keys, oa_data, BATCH_KEYS);
+    assert(sc->size == BATCH_KEYS && oa->size == BATCH_KEYS);
+
+    // Every odd key is a miss
+    for (int i = 0; i < BATCH_KEYS; i++)
+    {
+        keys[i] = (u32_t) i * 7U + (u32_t) (i % 2);
+    }
+    get_batch_sc(sc, keys, BATCH_KEYS, out);
+    for (int i = 0; i < BATCH_KEYS; i++)
+    {
+        assert(out[i] == (i % 2 == 0 ? sc_data[i] : NULL));
+    }
+    get_batch_oa(oa, keys, BATCH_KEYS, out);
+    for (int i = 0; i < BATCH_KEYS; i++)
+    {
+        assert(out[i] == (i % 2 == 0 ? oa_data[i] : NULL));
+    }
+    get_batch_sc(sc, keys, 0, out);
+
+    delete_hash_map_sc(sc);
+    delete_hash_map_oa(oa);
+    printf("PASSED\n");
+}
+
+static void test_hash_functions(void)
+{
+    printf("Test: HASH reference values, seeds and unaligned keys... ");
+    assert(hash_fnv1a("", 0, 0) == 0xCBF29CE484222325ULL);
+    assert(hash_fnv1a("a", 1, 0) == 0xAF63DC4C8601EC8CULL);
+    assert(hash_djb2("", 0, 0) == 5381U);
+    assert(hash_djb2("a", 1, 0) == ((5381U * 33U) ^ 'a'));
+
+    char buffer[64];
+    memcpy(buffer + 1, "word at a time hashing key", 26);
+    // Same bytes at another alignment, and the tail loop for lengths that are not word sized
+    for (size_t len = 0; len <= 26; len++)
+    {
+        assert(hash_murmur64a(buffer + 1, len, 7) ==
+               hash_murmur64a("word at a time hashing key", len, 7));
+    }
+    assert(hash_murmur64a("key", 3, 0) != hash_murmur64a("key", 3, 1));
+    assert(hash_murmur64a("key", 3, 0) != hash_murmur64a("kez", 3, 0));
+    assert(hash_mix32(1) != hash_mix32(2));
+    printf("PASSED\n");
+}
+
+static u64_t constant_hash(const void *key, size_t len, u64_t seed)
+{
+    (void) key;
+    (void) len;
+    return seed;
+}
+
+static void count_bytes_visit(const void *key, size_t key_len, void *data, void *ctx)
+{
+    assert(key_len > 0 && *(const char *) key == 'k');
+    assert(data != NULL);
+    (*(size_t *) ctx)++;
+}
+
+static void test_hm_bytes_per_hash(hash_fn_t hash)
+{
+    hash_map_bytes_t *map = init_hash_map_bytes(hash, 42);
+    char              key[32];
+
+    for (int i = 0; i < 2000; i++)
+    {
+        int len = snprintf(key, sizeof(key), "key-%d", i);
+        add_entry_bytes(map, key, (size_t) len, make_int(i));
+    }
+    assert(map->size == 2000);
+    assert(map->load_factor <= HASH_MAP_THRESHOLD);
+    for (int i = 0; i < 2000; i++)
+    {
+        int len = snprintf(key, sizeof(key), "key-%d", i);
+        assert(*(int *) get_entry_bytes(map, key, (size_t) len) == i);
+    }
+    // Prefixes and longer strings are different keys
+    assert(get_entry_bytes(map, "key-1", 4) == NULL);
+    assert(get_entry_bytes(map, "key-10000", 9) == NULL);
+
+    add_entry_bytes(map, "key-5", 5, make_int(-5));
+    assert(*(int *) get_entry_bytes(map, "key-5", 5) == -5);
+    assert(remove_entry_bytes(map, "key-5", 5));
+    assert(!remove_entry_bytes(map, "key-5", 5));
+
+    size_t visited = 0;
+    for_each_entry_bytes(map, count_bytes_visit, &visited);
+    assert(visited == 1999);
+    delete_hash_map_bytes(map);
+}
+
+static void test_hm_bytes_operations(void)
+{
+    printf("Test: HM byte keys with every hash function... ");
+    test_hm_bytes_per_hash(NULL);
+    test_hm_bytes_per_hash(hash_fnv1a);
+    test_hm_bytes_per_hash(hash_djb2);
+    printf("PASSED\n");
+}
+
+static void test_hm_bytes_collisions(void)
+{
+    printf("Test: HM byte keys compare bytes when every hash collides... ");
+    hash_map_bytes_t *map    = init_hash_map_bytes(constant_hash, 0);
+    const byte_t      blob[] = {0, 1, 0, 2};
+
+    add_entry_bytes(map, blob, 4, make_int(1));
+    add_entry_bytes(map, blob, 3, make_int(2));
+    add_entry_bytes(map, "", 0, make_int(3));
+    assert(*(int *) get_entry_bytes(map, blob, 4) == 1);
+    assert(*(int *) get_entry_bytes(map, blob, 3) == 2);
+    assert(*(int *) get_entry_bytes(map, "", 0) == 3);
+    assert(remove_entry_bytes(map, blob, 3));
+    assert(get_entry_bytes(map, blob, 3) == NULL);
+    assert(*(int *) get_entry_bytes(map, blob, 4) == 1);
+
+    delete_hash_map_bytes(map);
+    printf("PASSED\n");
+}
+
+static size_t stats_total(const hash_map_stats_t *stats, bool weighted)
+{
+    size_t total = 0;
+    for (size_t i = 0; i < HASH_MAP_STATS_BINS; i++)
+    {
+        total += stats->length_histogram[i] * (weighted ? i : 1);
+    }
+    return total;
+}
+
+static void test_hm_stats_shape(void)
+{
+    printf("Test: HM stats histograms cover every bucket or entry... ");
+    hash_map_sc_t    *sc    = init_hash_map();
+    hash_map_oa_t    *oa    = init_hash_map_oa();
+    hash_map_simd_t  *simd  = init_hash_map_simd();
+    hash_map_fc_t    *fc    = init_hash_map_fc();
+    hash_map_dense_t *dense = init_hash_map_dense();
+    for (int i = 0; i < 1000; i++)
+    {
+        u32_t key = (u32_t) i * 7;
+        add_entry_sc(sc, key, make_int(i));
+        add_entry_oa(oa, key, make_int(i));
+        add_entry_simd(simd, key, make_int(i));
+        add_entry_fc(fc, key, make_int(i));
+        add_entry_dense(dense, key, make_int(i));
+    }
+    hash_map_stats_t stats;
+
+    // Chaining: one histogram count per bucket, lengths add up to the entries
+    stats_sc(sc, &stats);
+    assert(stats.size == 1000 && stats_total(&stats, false) >= stats.capacity);
+    assert(stats.max_length < HASH_MAP_STATS_BINS - 1 && stats_total(&stats, true) == 1000);
+    stats_fc(fc, &stats);
+    assert(stats_total(&stats, false) == stats.capacity && stats_total(&stats, true) == 1000);
+
+    // Probing: one histogram count per entry
+    stats_oa(oa, &stats);
+    assert(stats_total(&stats, false) == 1000 && stats.load_factor <= HASH_MAP_THRESHOLD);
+    stats_simd(simd, &stats);
+    assert(stats_total(&stats, false) == 1000);
+    stats_dense(dense, &stats);
+    assert(stats_total(&stats, false) == 1000 && stats.capacity == dense->index_capacity);
+
+    delete_hash_map_sc(sc);
+    delete_hash_map_oa(oa);
+    delete_hash_map_simd(simd);
+    delete_hash_map_fc(fc);
+    delete_hash_map_dense(dense);
+    printf("PASSED\n");
+}
+
+static void test_hm_stats_bad_hash(void)
+{
+    printf("Test: HM stats expose a colliding hash and count lookups when enabled... ");
+    hash_map_bytes_t *map = init_hash_map_bytes(constant_hash, 0);
+    char              key[16];
+    for (int i = 0; i < 40; i++)
+    {
+        int len = snprintf(key, sizeof(key), "k%d", i);
+        add_entry_bytes(map, key, (size_t) len, make_int(i));
+    }
+    assert(get_entry_bytes(map, "k0", 2) != NULL);
+
+    hash_map_stats_t stats;
+    stats_bytes(map, &stats);
+    assert(stats.max_length == 40 && stats.length_histogram[HASH_MAP_STATS_BINS - 1] == 1);
+#ifdef HASH_MAP_STATS
+    assert(stats.counting && stats.lookups == 41 && stats.resizes >= 1);
+    assert(stats.probe_histogram[HASH_MAP_STATS_BINS - 1] > 0);
+#else
+    assert(!stats.counting && stats.lookups == 0 && stats.resizes == 0);
+#endif
+
+    FILE *report = tmpfile();
+    assert(report != NULL);
+    print_hash_map_stats(report, "bytes", &stats);
+    assert(ftell(report) > 0);
+    fclose(report);
+
+    delete_hash_map_bytes(map);
+    printf("PASSED\n");
+}
+
+/* ============================================
+ *          HASH MAP SNAPSHOT TESTS
+ * ============================================ */
+
+#define SNAPSHOT_TEST_PATH "/tmp/c_worl_snapshot_test.bin"
+
+static void test_snapshot_round_trip(void)
+{
+    printf("Test: SNAPSHOT build, write, map and look up... ");
+    snapshot_builder_t *builder = snapshot_builder_init();
+    char                key[32];
+    char                value[32];
+
+    for (int i = 0; i < 5000; i++)
+    {
+        int key_len   = snprintf(key, sizeof(key), "key-%d", i);
+        int value_len = snprintf(value, sizeof(value), "value-%d", i * 3);
+        snapshot_builder_add(builder, key, (size_t) key_len, value, (size_t) value_len);
+    }
+    snapshot_builder_add(builder, "key-7", 5, "replaced", 8);
+    snapshot_builder_add(builder, "empty", 5, "", 0);
+    assert(snapshot_builder_write(builder, SNAPSHOT_TEST_PATH));
+    snapshot_builder_destroy(builder);
+
+    hash_map_snapshot_t *snapshot = snapshot_open(SNAPSHOT_TEST_PATH);
+    assert(snapshot != NULL);
+    assert(snapshot_size(snapshot) == 5001);
+    for (int i = 0; i < 5000; i += 3)
+    {
+        if (i == 7)
+        {
+            continue;
+        }
+        int         key_len   = snprintf(key, sizeof(key), "key-%d", i);
+        int         value_len = snprintf(value, sizeof(value), "value-%d", i * 3);
+        size_t      found_len = 0;
+        const char *found = snapshot_get(snapshot, key, (size_t) key_len, &found_len);
+        assert(found != NULL && found_len == (size_t) value_len);
+        assert(memcmp(found, value, found_len) == 0);
+    }
+    size_t found_len = 99;
+    assert(memcmp(snapshot_get(snapshot, "key-7", 5, &found_len), "replaced", 8) == 0);
+    assert(snapshot_get(snapshot, "empty", 5, &found_len) != NULL && found_len == 0);
+    assert(snapshot_get(snapshot, "key-5000", 8, NULL) == NULL);
+    assert(snapshot_get(snapshot, "key-", 4, NULL) == NULL);
+
+    snapshot_close(snapshot);
+    remove(SNAPSHOT_TEST_PATH);
+    printf("PASSED\n");
+}
+
+static void test_snapshot_rejects_bad_files(void)
+{
+    printf("Test: SNAPSHOT rejects missing, short and corrupt files... ");
+    assert(snapshot_open("/tmp/c_worl_snapshot_missing.bin") == NULL);
+
+    FILE *file = fopen(SNAPSHOT_TEST_PATH, "wb");
+    assert(file != NULL);
+    fputs("CWSNAP\r\n but far too short", file);
+    fclose(file);
+    assert(snapshot_open(SNAPSHOT_TEST_PATH) == NULL);
+
+    snapshot_builder_t *builder = snapshot_builder_init();
+    snapshot_builder_add(builder, "a", 1, "b", 1);
+    assert(snapshot_builder_write(builder, SNAPSHOT_TEST_PATH));
+    snapshot_builder_destroy(builder);
+
+    // A heap claimed past the end of the file must fail validation, not be read
+    file = fopen(SNAPSHOT_TEST_PATH, "r+b");
+    assert(file != NULL);
+    u64_t heap_size = 1U << 20;
+    assert(fseek(file, (long) offsetof(snapshot_header_t, heap_size), SEEK_SET) == 0);
+    assert(fwrite(&heap_size, sizeof(heap_size), 1, file) == 1);
+    fclose(file);
+    assert(snapshot_open(SNAPSHOT_TEST_PATH) == NULL);
+
+    remove(SNAPSHOT_TEST_PATH);
+    printf("PASSED\n");
+}
+
+static void test_snapshot_rebuild_while_mapped(void)
+{
+    printf("Test: SNAPSHOT rebuild leaves an open mapping intact... ");
+    snapshot_builder_t *builder = snapshot_builder_init();
+    snapshot_builder_add(builder, "key", 3, "old", 3);
+    assert(snapshot_builder_write(builder, SNAPSHOT_TEST_PATH));
+    snapshot_builder_destroy(builder);
+    hash_map_snapshot_t *old_snapshot = snapshot_open(SNAPSHOT_TEST_PATH);
+    assert(old_snapshot != NULL);
+
+    // A bigger rebuild: rewriting the file in place would cut the old mapping's pages short
+    char key[32];
+    builder = snapshot_builder_init();
+    for (int i = 0; i < 1000; i++)
+    {
+        int key_len = snprintf(key, sizeof(key), "other-%d", i);
+        snapshot_builder_add(builder, key, (size_t) key_len, "x", 1);
+    }
+    snapshot_builder_add(builder, "key", 3, "new value", 9);
+    assert(snapshot_builder_write(builder, SNAPSHOT_TEST_PATH));
+    snapshot_builder_destroy(builder);
+
+    size_t found_len = 0;
+    assert(snapshot_size(old_snapshot) == 1);
+    assert(memcmp(snapshot_get(old_snapshot, "key", 3, &found_len), "old", 3) == 0);
+    assert(found_len == 3);
+    hash_map_snapshot_t *new_snapshot = snapshot_open(SNAPSHOT_TEST_PATH);
+    assert(new_snapshot != NULL && snapshot_size(new_snapshot) == 1001);
+    assert(memcmp(snapshot_get(new_snapshot, "key", 3, &found_len), "new value", 9) == 0);
+    assert(fopen(SNAPSHOT_TEST_PATH ".tmp", "rb") == NULL);
+
+    snapshot_close(old_snapshot);
+    snapshot_close(new_snapshot);
+    remove(SNAPSHOT_TEST_PATH);
+    printf("PASSED\n");
+}
+
+/* ============================================
+ *          PERFECT HASH TESTS
+ * ============================================ */
+
+#define MPH_TEST_KEYS 300000 // Enough for several build threads
+
+static void test_mph_bijection(void)
+{
+    printf("Test: MPH maps the key set onto [0, n), same result on 1 and 4 threads... ");
+    u32_t *keys = malloc(MPH_TEST_KEYS * sizeof(u32_t));
+    char  *hits = calloc(MPH_TEST_KEYS, 1);
+    assert(keys != NULL && hits != NULL);
+    for (u32_t i = 0; i < MPH_TEST_KEYS; i++)
+    {
+        keys[i] = i * 2654435761U;
+    }
+
+    perfect_hash_t *serial   = mph_build(keys, MPH_TEST_KEYS, 1);
+    perfect_hash_t *parallel = mph_build(keys, MPH_TEST_KEYS, 4);
+    assert(serial != NULL && parallel != NULL);
+    for (size_t i = 0; i < MPH_TEST_KEYS; i++)
+    {
+        size_t index = mph_lookup(parallel, keys[i]);
+        assert(index < MPH_TEST_KEYS && hits[index] == 0);
+        assert(mph_lookup(serial, keys[i]) == index);
+        hits[index] = 1;
+    }
+    assert(mph_bits_per_key(parallel) < 5.0);
+
+    mph_destroy(serial);
+    mph_destroy(parallel);
+    free(hits);
+    free(keys);
+    printf("PASSED\n");
+}
+
+static void test_mph_edge_cases(void)
+{
+    printf("Test: MPH empty set, single key and duplicate keys... ");
+    perfect_hash_t *empty = mph_build(NULL, 0, 0);
+    assert(empty != NULL && mph_lookup(empty, 42) == MPH_NOT_FOUND);
+    mph_destroy(empty);
+
+    u32_t           one[]  = {7};
+    perfect_hash_t *single = mph_build(one, 1, 0);
+    assert(single != NULL && mph_lookup(single, 7) == 0);
+    mph_destroy(single);
+
+    u32_t duplicates[] = {1, 2, 3, 2, 5};
+    assert(mph_build(duplicates, 5, 0) == NULL);
+    mph_destroy(NULL);
+    printf("PASSED\n");
+}
+
+static void test_perfect_map(void)
+{
+    printf("Test: PERFECT MAP get hits and rejects other keys... ");
+    u32_t keys[1000];
+    void *values[1000];
+    for (u32_t i = 0; i < 1000; i++)
+    {
+        int *value = malloc(sizeof(int));
+        assert(value != NULL);
+        *value    = (int) i;
+        keys[i]   = i * 7 + 3;
+        values[i] = value;
+    }
+    perfect_map_t *map = perfect_map_build(keys, values, 1000, 0);
+    assert(map != NULL);
+    for (u32_t i = 0; i < 1000; i++)
+    {
+        int *value = perfect_map_get(map, i * 7 + 3);
+        assert(value != NULL && *value == (int) i);
+        assert(perfect_map_get(map, i * 7 + 4) == NULL);
+    }
+    perfect_map_destroy(map);
+    printf("PASSED\n");
+}
+
+/* ============================================
+ *          CONCURRENT MAP TESTS
+ * ============================================ */
+
+#define CMAP_TEST_THREADS 4
+#define CMAP_TEST_KEYS    2000
+
+typedef struct cmap_worker_t
+{
+    concurrent_map_t *map;
+    int               first_key;
+} cmap_worker_t;
+
+static void copy_int_visit(u32_t key, void *data, void *ctx)
+{
+    (void) key;
+    *(int *) ctx = *(int *) data;
+}
+
+static void *cmap_worker(void *arg)
+{
+    cmap_worker_t *worker = arg;
+    for (int i = 0; i < CMAP_TEST_KEYS; i++)
+    {
+        int key = worker->first_key + i;
+        cmap_put(worker->map, (u32_t) key, make_int(key));
+        int value = -1;
+        assert(cmap_get(worker->map, (u32_t) key, copy_int_visit, &value));
+        assert(value == key);
+    }
+    for (int i = 0; i < CMAP_TEST_KEYS; i += 2)
+    {
+        assert(cmap_remove(worker->map, (u32_t) (worker->first_key + i)));
+    }
+    return NULL;
+}
+
+static void test_cmap_operations(void)
+{
+    printf("Test: CMAP put/get/remove and shard rounding... ");
+    concurrent_map_t *map = cmap_init(5);
+    assert(cmap_shard_count(map) == 8);
+
+    cmap_put(map, 1, make_int(10));
+    cmap_put(map, 1, make_int(11));
+    int value = 0;
+    assert(cmap_get(map, 1, copy_int_visit, &value) && value == 11);
+    assert(!cmap_get(map, 2, NULL, NULL));
+    assert(cmap_size(map) == 1);
+    assert(cmap_remove(map, 1));
+    assert(!cmap_remove(map, 1));
+    assert(cmap_size(map) == 0);
+    cmap_destroy(map);
+
+    map = cmap_init(1);
+    cmap_put(map, 7, make_int(7));
+    assert(cmap_get(map, 7, NULL, NULL));
+    cmap_destroy(map);
+    printf("PASSED\n");
+}
+
+static void test_cmap_threads(void)
+{
+    printf("Test: CMAP writers on several threads... ");
+    concurrent_map_t *map = cmap_init(0);
+    pthread_t         threads[CMAP_TEST_THREADS];
+    cmap_worker_t     workers[CMAP_TEST_THREADS];
+
+    for (int t = 0; t < CMAP_TEST_THREADS; t++)
+    {
+        workers[t].map       = map;
+        workers[t].first_key = t * CMAP_TEST_KEYS;
+        assert(pthread_create(&threads[t], NULL, cmap_worker, &workers[t]) == 0);
+    }
+    for (int t = 0; t < CMAP_TEST_THREADS; t++)
+    {
+        assert(pthread_join(threads[t], NULL) == 0);
+    }
+
+    assert(cmap_size(map) == CMAP_TEST_THREADS * CMAP_TEST_KEYS / 2);
+    for (int key = 0; key < CMAP_TEST_THREADS * CMAP_TEST_KEYS; key++)
+    {
+        assert(cmap_get(map, (u32_t) key, NULL, NULL) == (key % 2 == 1));
+    }
+    cmap_destroy(map);
+    printf("PASSED\n");
+}
+
+/* ============================================
+ *          LRU CACHE TESTS
+ * ============================================ */
+
+#define LRU_TEST_THREADS 4
+#define LRU_TEST_KEYS    3000
+#define LRU_TEST_BOUND   800
+
+static void test_lru_order(void)
+{
+    printf("Test: LRU get refreshes, put evicts the least recent... ");
+    lru_cache_t *cache = lru_init(3, 0);
+    lru_put(cache, 1, make_int(1), 1);
+    lru_put(cache, 2, make_int(2), 1);
+    lru_put(cache, 3, make_int(3), 1);
+    assert(*(int *) lru_get(cache, 1) == 1);
+
+    assert(lru_put(cache, 4, make_int(4), 1));
+    assert(lru_get(cache, 2) == NULL);
+    assert(cache->evictions == 1 && cache->index->size == 3);
+    assert(cache->order->head->key == 4 && cache->order->tail->key == 3);
+
+    // Replacing refreshes too, so 1 is now the one to go
+    assert(lru_put(cache, 3, make_int(30), 1));
+    assert(lru_put(cache, 5, make_int(5), 1));
+    assert(lru_get(cache, 1) == NULL && *(int *) lru_get(cache, 3) == 30);
+    assert(cache->hits == 2 && cache->misses == 2);
+
+    assert(lru_remove(cache, 4));
+    assert(!lru_remove(cache, 4));
+    assert(cache->order->len == 2 && cache->index->size == 2);
+    lru_destroy(cache);
+    printf("PASSED\n");
+}
+
+static void test_lru_bytes(void)
+{
+    printf("Test: LRU byte budget evicts by size and rejects oversized values... ");
+    lru_cache_t *cache = lru_init(0, 100);
+    lru_put(cache, 1, make_int(1), 40);
+    lru_put(cache, 2, make_int(2), 40);
+    assert(cache->bytes == 80);
+
+    assert(lru_put(cache, 3, make_int(3), 30));
+    assert(lru_get(cache, 1) == NULL && cache->bytes == 70);
+    assert(lru_put(cache, 2, make_int(2), 71));
+    assert(lru_get(cache, 3) == NULL && cache->bytes == 71);
+
+    assert(!lru_put(cache, 4, make_int(4), 101));
+    assert(lru_get(cache, 4) == NULL && cache->bytes == 71);
+    assert(lru_remove(cache, 2) && cache->bytes == 0);
+    lru_destroy(cache);
+    printf("PASSED\n");
+}
+
+static void *lru_worker(void *arg)
+{
+    lru_sharded_t *cache = arg;
+    for (int i = 0; i < LRU_TEST_KEYS; i++)
+    {
+        u32_t key   = (u32_t) (i % 1000);
+        int   value = -1;
+        if (lru_sharded_get(cache, key, copy_int_visit, &value))
+        {
+            assert(value == (int) key);
+        }
+        else
+        {
+            lru_sharded_put(cache, key, make_int((int) key), 1);
+        }
+    }
+    return NULL;
+}
+
+static void test_lru_sharded_threads(void)
+{
+    printf("Test: LRU sharded cache stays within its bound on several threads... ");
+    lru_sharded_t *cache = lru_sharded_init(5, LRU_TEST_BOUND, 0);
+    pthread_t      threads[LRU_TEST_THREADS];
+    assert(lru_sharded_shard_count(cache) == 8);
+
+    for (int t = 0; t < LRU_TEST_THREADS; t++)
+    {
+        assert(pthread_create(&threads[t], NULL, lru_worker, cache) == 0);
+    }
+    for (int t = 0; t < LRU_TEST_THREADS; t++)
+    {
+        assert(pthread_join(threads[t], NULL) == 0);
+    }
+    assert(lru_sharded_size(cache) <= LRU_TEST_BOUND && lru_sharded_size(cache) > 0);
+    assert(lru_sharded_put(cache, 5000, make_int(5000), 1));
+    assert(lru_sharded_get(cache, 5000, NULL, NULL));
+    assert(lru_sharded_remove(cache, 5000) && !lru_sharded_get(cache, 5000, NULL, NULL));
+    lru_sharded_destroy(cache);
+    printf("PASSED\n");
+}
+
+static void test_lru_sharded_bounds(void)
+{
+    printf("Test: LRU sharded totals hold with more shards than entries or bytes... ");
+    // 10 entries over the default 64 shards: capped to 8 shards whose shares add up to 10
+    lru_sharded_t *cache = lru_sharded_init(0, 10, 0);
+    assert(lru_sharded_shard_count(cache) == 8);
+    for (int i = 0; i < 1000; i++)
+    {
+        assert(lru_sharded_put(cache, (u32_t) i, make_int(i), 1));
+    }
+    assert(lru_sharded_size(cache) == 10);
+    lru_sharded_destroy(cache);
+
+    // 1 MiB over 64 shards: any value up to 16 KiB fits its shard, a bigger one is refused
+    size_t max_bytes = (size_t) 1 << 20;
+    cache            = lru_sharded_init(0, 0, max_bytes);
+    size_t share     = max_bytes / lru_sharded_shard_count(cache);
+    for (int i = 0; i < 100; i++)
+    {
+        assert(lru_sharded_put(cache, (u32_t) i, make_int(i), share));
+    }
+    assert(!lru_sharded_put(cache, 100, make_int(100), share + 1));
+    assert(!lru_sharded_get(cache, 100, NULL, NULL));
+    lru_sharded_destroy(cache);
+
+    // Fewer bytes than shards: no shard may end up with a zero share, which means unbounded
+    cache = lru_sharded_init(0, 0, 40);
+    assert(lru_sharded_shard_count(cache) == 32);
+    for (int i = 0; i < 1000; i++)
+    {
+        assert(lru_sharded_put(cache, (u32_t) i, make_int(i), 1));
+    }
+    assert(lru_sharded_size(cache) == 40);
+    lru_sharded_destroy(cache);
+    printf("PASSED\n");
+}
+
+/* ============================================
+ *               MAIN
+ * ============================================ */
+
+int main(void)
+{
+    printf("\n========================================\n");
+    printf("         DYNAMIC ARRAY TESTS\n");
+    printf("========================================\n\n");
+
+    test_da_init_and_destroy();
+    test_da_push_single();
+    test_da_push_and_get();
+    test_da_pop();
     test_da_pop_empty();
     test_da_pop_until_empty();
     test_da_is_empty();
@@ -1075,6 +3290,42 @@ int main(void)
     test_da_null_elements();
     test_da_lifo_order();
     test_da_push_pop_interleaved();
+    test_da_geometric_growth();
+    test_da_init_with_capacity();
+    test_da_reserve();
+    test_da_shrink_to_fit();
+    test_da_insert_range();
+    test_da_erase_range();
+    test_da_push_n();
+    test_da_append_array();
+    test_da_init_no_data_alloc();
+    test_da_inline_on_stack();
+    test_da_inline_shrink_back();
+
+    printf("\n========================================\n");
+    printf("          TYPED ARRAY TESTS\n");
+    printf("========================================\n\n");
+
+    test_ta_push_get_pop();
+    test_ta_pop_empty();
+    test_ta_set_insert_erase();
+    test_ta_struct_values();
+
+    printf("\n========================================\n");
+    printf("        SEGMENTED ARRAY TESTS\n");
+    printf("========================================\n\n");
+
+    test_sa_push_get_across_chunks();
+    test_sa_stable_addresses();
+    test_sa_pop_releases_chunks();
+
+    printf("\n========================================\n");
+    printf("              DEQUE TESTS\n");
+    printf("========================================\n\n");
+
+    test_dq_push_pop_both_ends();
+    test_dq_growth_while_wrapped();
+    test_dq_queue_churn();
 
     printf("\n========================================\n");
     printf("          LINKED LIST TESTS\n");
@@ -1110,9 +3361,109 @@ int main(void)
     test_ll_insert_preserves_links();
     test_ll_remove_preserves_links();
     test_ll_insert_then_remove();
+    test_ll_get_element_from_tail_side();
+    test_ll_cursor_walk();
+    test_ll_cursor_edit();
+    test_ll_sort_stable();
+    test_ll_sort_large();
+    test_ll_merge();
+    test_ll_splice_split();
+
+    printf("\n========================================\n");
+    printf("         POOL ALLOCATOR TESTS\n");
+    printf("========================================\n\n");
+
+    test_pool_alloc_reuse();
+    test_ll_pooled_private();
+    test_ll_pooled_shared();
+
+    printf("\n========================================\n");
+    printf("         UNROLLED LIST TESTS\n");
+    printf("========================================\n\n");
+
+    test_ul_push_get_pop();
+    test_ul_insert_splits();
+    test_ul_remove_merges();
+
+    printf("\n========================================\n");
+    printf("            SKIP LIST TESTS\n");
+    printf("========================================\n\n");
+
+    test_sl_push_get_pop();
+    test_sl_insert_remove_match_array();
+    test_sl_drain();
+
+    printf("\n========================================\n");
+    printf("         INTRUSIVE LIST TESTS\n");
+    printf("========================================\n\n");
+
+    test_il_push_pop_container_of();
+    test_il_object_on_two_lists();
+
+    printf("\n========================================\n");
+    printf("          COMPACT LIST TESTS\n");
+    printf("========================================\n\n");
+
+    test_cl_operations();
+    test_cl_slot_reuse();
+    test_cl_clone();
+
+    printf("\n========================================\n");
+    printf("            HASH MAP TESTS\n");
+    printf("========================================\n\n");
+
+    test_hm_sc_operations();
+    test_hm_sc_incremental_rehash();
+    test_hm_oa_operations();
+    test_hm_oa_backward_shift();
+    test_hm_simd_operations();
+    test_hm_simd_tombstone_churn();
+    test_hm_fc_operations();
+    test_hm_fc_chains();
+    test_hm_dense_operations();
+    test_hm_dense_order();
+    test_hm_dense_churn();
+    test_hm_batches();
+    test_hash_functions();
+    test_hm_bytes_operations();
+    test_hm_bytes_collisions();
+    test_hm_stats_shape();
+    test_hm_stats_bad_hash();
+
+    printf("\n========================================\n");
+    printf("        HASH MAP SNAPSHOT TESTS\n");
+    printf("========================================\n\n");
+
+    test_snapshot_round_trip();
+    test_snapshot_rejects_bad_files();
+    test_snapshot_rebuild_while_mapped();
+
+    printf("\n========================================\n");
+    printf("          PERFECT HASH TESTS\n");
+    printf("========================================\n\n");
+
+    test_mph_bijection();
+    test_mph_edge_cases();
+    test_perfect_map();
+
+    printf("\n========================================\n");
+    printf("         CONCURRENT MAP TESTS\n");
+    printf("========================================\n\n");
+
+    test_cmap_operations();
+    test_cmap_threads();
+
+    printf("\n========================================\n");
+    printf("            LRU CACHE TESTS\n");
+    printf("========================================\n\n");
+
+    test_lru_order();
+    test_lru_bytes();
+    test_lru_sharded_threads();
+    test_lru_sharded_bounds();
 
     printf("\n========================================\n");
-    printf("    All 50 tests completed\n");
+    printf("    All 121 tests completed\n");
     printf("========================================\n\n");
 
     return EXIT_SUCCESS;
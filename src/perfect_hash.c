@@ -0,0 +1,356 @@
+/**
+ * @file perfect_hash.c
+ * @brief BBHash style minimal perfect hash with a threaded level build, and the static map on it
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "perfect_hash.h"
+
+#include "utils.h"
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define MPH_WORD_BITS        64U
+#define MPH_SEED             0x243F6A8885A308D3ULL // Digits of pi, any odd constant works
+#define MPH_LEVEL_MUL        0x9E3779B97F4A7C15ULL // 2^64 / golden ratio
+#define MPH_MIN_THREAD_KEYS  65536U                // Smaller shares cost more to spawn than run
+#define MPH_CACHE_LINE       64U                   // MPH_RANK_WORDS words
+
+/*
+ * @brief One thread's share of the keys of a level, and the keys it sends to the next one
+ */
+typedef struct mph_worker_t
+{
+    const u32_t    *keys;
+    size_t          begin;
+    size_t          end;
+    _Atomic(u64_t) *seen;
+    _Atomic(u64_t) *collide;
+    size_t          level;
+    size_t          level_bits;
+    u64_t           seed;
+    u32_t          *survivors; // Written from index begin, the share never grows
+    size_t          survivor_count;
+} mph_worker_t;
+
+/*
+ * @brief splitmix64 finalizer of the key under the level's seed
+ */
+static u64_t mph_hash(u32_t key, size_t level, u64_t seed)
+{
+    u64_t x = (u64_t) key ^ (seed + (u64_t) (level + ONE) * MPH_LEVEL_MUL);
+    x ^= x >> 30U;
+    x *= 0xBF58476D1CE4E5B9ULL;
+    x ^= x >> 27U;
+    x *= 0x94D049BB133111EBULL;
+    x ^= x >> 31U;
+    return x;
+}
+
+/*
+ * @brief Bit of the level hit by key, the top 32 hash bits scaled to the level size (no modulo)
+ */
+static size_t mph_position(u32_t key, size_t level, u64_t seed, size_t level_bits)
+{
+    return (size_t) (((mph_hash(key, level, seed) >> 32U) * (u64_t) level_bits) >> 32U);
+}
+
+static void *mph_mark(void *arg)
+{
+    mph_worker_t *worker = arg;
+    for (size_t i = worker->begin; i < worker->end; i++)
+    {
+        u32_t  key  = worker->keys[i];
+        size_t pos  = mph_position(key, worker->level, worker->seed, worker->level_bits);
+        u64_t  mask = (u64_t) ONE << (pos % MPH_WORD_BITS);
+        u64_t  old  = atomic_fetch_or_explicit(&worker->seen[pos / MPH_WORD_BITS], mask,
+                                               memory_order_relaxed);
+        if ((old & mask) != ZERO)
+        {
+            atomic_fetch_or_explicit(&worker->collide[pos / MPH_WORD_BITS], mask,
+                                     memory_order_relaxed);
+        }
+    }
+    return NULL;
+}
+
+static void *mph_split(void *arg)
+{
+    mph_worker_t *worker = arg;
+    worker->survivor_count = ZERO;
+    for (size_t i = worker->begin; i < worker->end; i++)
+    {
+        u32_t  key  = worker->keys[i];
+        size_t pos  = mph_position(key, worker->level, worker->seed, worker->level_bits);
+        u64_t  word = atomic_load_explicit(&worker->collide[pos / MPH_WORD_BITS],
+                                           memory_order_relaxed);
+        if ((word >> (pos % MPH_WORD_BITS) & ONE) != ZERO)
+        {
+            worker->survivors[worker->begin + worker->survivor_count++] = key;
+        }
+    }
+    return NULL;
+}
+
+/*
+ * @brief Run fn on every worker, the first one on the calling thread, and wait for all
+ */
+static void mph_run(mph_worker_t *workers, size_t count, void *(*fn)(void *))
+{
+    pthread_t *threads = malloc(count * sizeof(pthread_t));
+    check_mem_alloc(threads, "Perfect hash threads");
+    for (size_t i = 1; i < count; i++)
+    {
+        if (pthread_create(&threads[i], NULL, fn, &workers[i]) != 0)
+        {
+            throw_error(" CREATING PERFECT HASH THREAD");
+        }
+    }
+    fn(&workers[0]);
+    for (size_t i = 1; i < count; i++)
+    {
+        pthread_join(threads[i], NULL);
+    }
+    free(threads);
+}
+
+/*
+ * @brief Place every key alone on its bit of a new level, return the colliding ones in survivors
+ */
+static size_t mph_build_level(perfect_hash_t *hash, const u32_t *keys, size_t count,
+                              u32_t *survivors, mph_worker_t *workers, size_t threads)
+{
+    size_t level = hash->level_count;
+    size_t words = (count * MPH_GAMMA + MPH_WORD_BITS - ONE) / MPH_WORD_BITS;
+
+    _Atomic(u64_t) *seen    = calloc(words, sizeof(u64_t));
+    _Atomic(u64_t) *collide = calloc(words, sizeof(u64_t));
+    check_mem_alloc(seen, "Perfect hash level");
+    check_mem_alloc(collide, "Perfect hash level");
+
+    size_t share = (count + threads - ONE) / threads;
+    for (size_t t = 0; t < threads; t++)
+    {
+        size_t begin = t * share < count ? t * share : count;
+        workers[t]   = (mph_worker_t) {keys, begin, begin + share < count ? begin + share : count,
+                                       seen, collide, level, words * MPH_WORD_BITS, hash->seed,
+                                       survivors, ZERO};
+    }
+    mph_run(workers, threads, mph_mark);
+    mph_run(workers, threads, mph_split);
+
+    // Shares are packed front to back, each destination starts at or before its source
+    size_t survivor_count = ZERO;
+    for (size_t t = 0; t < threads; t++)
+    {
+        memmove(survivors + survivor_count, survivors + workers[t].begin,
+                workers[t].survivor_count * sizeof(u32_t));
+        survivor_count += workers[t].survivor_count;
+    }
+
+    // Cache line aligned, a rank block and the word it ends in share one line
+    size_t bytes = (hash->word_count + words) * sizeof(u64_t);
+    bytes        = (bytes + MPH_CACHE_LINE - ONE) & ~((size_t) MPH_CACHE_LINE - ONE);
+    u64_t *bits  = aligned_alloc(MPH_CACHE_LINE, bytes);
+    check_mem_alloc(bits, "Perfect hash bits");
+    if (hash->bits != NULL)
+    {
+        memcpy(bits, hash->bits, hash->word_count * sizeof(u64_t));
+        free(hash->bits);
+    }
+    hash->bits = bits;
+    for (size_t i = 0; i < words; i++)
+    {
+        hash->bits[hash->word_count + i] =
+            atomic_load_explicit(&seen[i], memory_order_relaxed) &
+            ~atomic_load_explicit(&collide[i], memory_order_relaxed);
+    }
+    hash->level_word[level] = hash->word_count;
+    hash->level_bits[level] = words * MPH_WORD_BITS;
+    hash->word_count += words;
+    hash->level_count++;
+
+    free(seen);
+    free(collide);
+    return survivor_count;
+}
+
+static void mph_build_ranks(perfect_hash_t *hash)
+{
+    size_t blocks = hash->word_count / MPH_RANK_WORDS + ONE;
+    hash->ranks   = malloc(blocks * sizeof(u64_t));
+    check_mem_alloc(hash->ranks, "Perfect hash ranks");
+    u64_t rank = ZERO;
+    for (size_t i = 0; i < hash->word_count; i++)
+    {
+        if (i % MPH_RANK_WORDS == ZERO)
+        {
+            hash->ranks[i / MPH_RANK_WORDS] = rank;
+        }
+        rank += (u64_t) __builtin_popcountll(hash->bits[i]);
+    }
+}
+
+static size_t mph_thread_count(size_t threads, size_t count)
+{
+    if (threads == ZERO)
+    {
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        threads     = online > 0 ? (size_t) online : ONE;
+    }
+    size_t useful = count / MPH_MIN_THREAD_KEYS;
+    if (threads > useful)
+    {
+        threads = useful;
+    }
+    return threads > ZERO ? threads : ONE;
+}
+
+perfect_hash_t *mph_build(const u32_t *keys, size_t count, size_t threads)
+{
+    // Level positions scale 32 hash bits, a level must stay below 2^32 bits
+    if (count > UINT32_MAX / MPH_GAMMA)
+    {
+        throw_error(" TOO MANY KEYS FOR PERFECT HASH");
+    }
+    perfect_hash_t *hash = calloc(1, sizeof(perfect_hash_t));
+    check_mem_alloc(hash, "Perfect hash init");
+    hash->key_count = count;
+    hash->seed      = MPH_SEED;
+
+    // Level 0 reads the caller's keys, later levels alternate between two scratch buffers
+    u32_t *scratch[2] = {malloc((count + ONE) * sizeof(u32_t)), NULL};
+    check_mem_alloc(scratch[0], "Perfect hash scratch");
+    size_t        max_threads = mph_thread_count(threads, count);
+    mph_worker_t *workers     = malloc(max_threads * sizeof(mph_worker_t));
+    check_mem_alloc(workers, "Perfect hash workers");
+
+    const u32_t *current   = keys;
+    size_t       remaining = count;
+    while (remaining > ZERO && hash->level_count < MPH_MAX_LEVELS)
+    {
+        u32_t *out = scratch[hash->level_count % 2];
+        size_t next_count =
+            mph_build_level(hash, current, remaining, out, workers,
+                            mph_thread_count(max_threads, remaining));
+        if (scratch[1] == NULL)
+        {
+            scratch[1] = malloc((next_count + ONE) * sizeof(u32_t));
+            check_mem_alloc(scratch[1], "Perfect hash scratch");
+        }
+        current   = out;
+        remaining = next_count;
+    }
+    free(scratch[0]);
+    free(scratch[1]);
+    free(workers);
+
+    // Equal keys always share a bit, so they collide on every level
+    if (remaining > ZERO)
+    {
+        free(hash->bits);
+        free(hash);
+        return NULL;
+    }
+    mph_build_ranks(hash);
+    return hash;
+}
+
+void mph_destroy(perfect_hash_t *hash)
+{
+    if (hash == NULL)
+    {
+        return;
+    }
+    free(hash->bits);
+    free(hash->ranks);
+    free(hash);
+}
+
+size_t mph_lookup(const perfect_hash_t *hash, u32_t key)
+{
+    for (size_t level = 0; level < hash->level_count; level++)
+    {
+        size_t pos  = hash->level_word[level] * MPH_WORD_BITS +
+                     mph_position(key, level, hash->seed, hash->level_bits[level]);
+        size_t word = pos / MPH_WORD_BITS;
+        u64_t  bit  = (u64_t) ONE << (pos % MPH_WORD_BITS);
+        if ((hash->bits[word] & bit) == ZERO)
+        {
+            continue;
+        }
+        u64_t rank = hash->ranks[word / MPH_RANK_WORDS];
+        for (size_t i = word - word % MPH_RANK_WORDS; i < word; i++)
+        {
+            rank += (u64_t) __builtin_popcountll(hash->bits[i]);
+        }
+        return (size_t) (rank + (u64_t) __builtin_popcountll(hash->bits[word] & (bit - ONE)));
+    }
+    return MPH_NOT_FOUND;
+}
+
+double mph_bits_per_key(const perfect_hash_t *hash)
+{
+    if (hash->key_count == ZERO)
+    {
+        return 0.0;
+    }
+    size_t words = hash->word_count + hash->word_count / MPH_RANK_WORDS + ONE;
+    return (double) (words * MPH_WORD_BITS) / (double) hash->key_count;
+}
+
+/* ================================================================================================
+ * STATIC MAP
+ * ================================================================================================
+ */
+
+perfect_map_t *perfect_map_build(const u32_t *keys, void *const *values, size_t count,
+                                 size_t threads)
+{
+    perfect_hash_t *hash = mph_build(keys, count, threads);
+    if (hash == NULL)
+    {
+        return NULL;
+    }
+    perfect_map_t *map = malloc(sizeof(perfect_map_t));
+    check_mem_alloc(map, "Perfect map init");
+    map->hash    = hash;
+    map->entries = malloc((count + ONE) * sizeof(perfect_entry_t));
+    check_mem_alloc(map->entries, "Perfect map entries");
+    for (size_t i = 0; i < count; i++)
+    {
+        map->entries[mph_lookup(hash, keys[i])] = (perfect_entry_t) {keys[i], values[i]};
+    }
+    return map;
+}
+
+void perfect_map_destroy(perfect_map_t *map)
+{
+    if (map == NULL)
+    {
+        return;
+    }
+    for (size_t i = 0; i < map->hash->key_count; i++)
+    {
+        free(map->entries[i].data);
+    }
+    mph_destroy(map->hash);
+    free(map->entries);
+    free(map);
+}
+
+void *perfect_map_get(const perfect_map_t *map, u32_t key)
+{
+    size_t index = mph_lookup(map->hash, key);
+    if (index == MPH_NOT_FOUND || map->entries[index].key != key)
+    {
+        return NULL;
+    }
+    return map->entries[index].data;
+}
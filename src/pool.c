@@ -0,0 +1,103 @@
+/**
+ * @file pool.c
+ * @brief Slab pool with a free list
+ */
+
+#include "pool.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+
+/*
+ * @brief malloc one more slab and point the bump allocator at it. O(1)
+ */
+static void pool_add_slab(pool_t *pool)
+{
+    if (pool->objects_per_slab > (SIZE_MAX - sizeof(pool_slab_t)) / pool->object_size)
+    {
+        throw_error("Pool slab size overflow");
+    }
+    pool_slab_t *slab = malloc(sizeof(pool_slab_t) + pool->objects_per_slab * pool->object_size);
+    check_mem_alloc(slab, "Pool slab");
+    slab->next     = pool->slabs;
+    slab->capacity = pool->objects_per_slab;
+    pool->slabs    = slab;
+    pool->bump     = (byte_t *) (slab + 1);
+    pool->bump_end = pool->bump + slab->capacity * pool->object_size;
+}
+
+pool_t *pool_init(size_t object_size, size_t objects_per_slab)
+{
+    pool_t *pool = malloc(sizeof(pool_t));
+    check_mem_alloc(pool, "Pool init");
+
+    // Every object must be able to hold the free list link
+    if (object_size < sizeof(void *))
+    {
+        object_size = sizeof(void *);
+    }
+    pool->object_size      = (object_size + POOL_ALIGNMENT - ONE) & ~(POOL_ALIGNMENT - ONE);
+    pool->objects_per_slab = objects_per_slab;
+    if (objects_per_slab == ZERO)
+    {
+        pool->objects_per_slab = POOL_DEFAULT_SLAB_OBJECTS;
+    }
+    pool->slabs     = NULL;
+    pool->free_list = NULL;
+    pool->bump      = NULL;
+    pool->bump_end  = NULL;
+    pool->live      = ZERO;
+    return pool;
+}
+
+void pool_destroy(pool_t *pool)
+{
+    if (pool == NULL)
+    {
+        return;
+    }
+    pool_slab_t *slab = pool->slabs;
+    while (slab != NULL)
+    {
+        pool_slab_t *next = slab->next;
+        free(slab);
+        slab = next;
+    }
+    free(pool);
+}
+
+void *pool_alloc(pool_t *pool)
+{
+    void *object = pool->free_list;
+    if (object != NULL)
+    {
+        pool->free_list = *(void **) object;
+    }
+    else
+    {
+        if (pool->bump == pool->bump_end)
+        {
+            pool_add_slab(pool);
+        }
+        object = pool->bump;
+        pool->bump += pool->object_size;
+    }
+    pool->live++;
+    return object;
+}
+
+void pool_free(pool_t *pool, void *object)
+{
+    if (object == NULL)
+    {
+        return;
+    }
+    *(void **) object = pool->free_list;
+    pool->free_list   = object;
+    pool->live--;
+}
+
+size_t pool_live(const pool_t *pool)
+{
+    return pool->live;
+}
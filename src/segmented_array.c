@@ -0,0 +1,137 @@
+/**
+ * @file segmented_array.c
+ * @brief Chunked array with stable element addresses
+ */
+
+#include "segmented_array.h"
+
+#include "utils.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/*
+ * @brief Append one chunk, growing the directory geometrically when it is full. O(1) amortized
+ */
+static bool segarray_add_chunk(segmented_array_t *arr)
+{
+    if (arr->chunk_count == arr->dir_capacity)
+    {
+        if (arr->dir_capacity > SIZE_MAX / sizeof(void **) / 2)
+        {
+            return FALSE;
+        }
+        size_t  new_capacity = arr->dir_capacity * 2;
+        void ***new_dir =
+            (void ***) realloc((void *) arr->chunks, new_capacity * sizeof(void **));
+        if (new_dir == NULL)
+        {
+            fprintf(stderr, "ERROR REALOCATING SEGMENT DIRECTORY\n");
+            return FALSE;
+        }
+        arr->chunks       = new_dir;
+        arr->dir_capacity = new_capacity;
+    }
+
+    void **chunk = (void **) malloc(SEGARRAY_CHUNK_SIZE * sizeof(void *));
+    if (chunk == NULL)
+    {
+        fprintf(stderr, "ERROR ALLOCATING SEGMENT\n");
+        return FALSE;
+    }
+    arr->chunks[arr->chunk_count++] = chunk;
+    return TRUE;
+}
+
+segmented_array_t *segarray_init(void)
+{
+    segmented_array_t *arr = malloc(sizeof(segmented_array_t));
+    check_mem_alloc(arr, "Segmented array init");
+    arr->chunks = (void ***) malloc(SEGARRAY_INITIAL_DIRECTORY * sizeof(void **));
+    check_mem_alloc((void *) arr->chunks, "Segmented array directory");
+    arr->chunk_count  = ZERO;
+    arr->dir_capacity = SEGARRAY_INITIAL_DIRECTORY;
+    arr->size         = ZERO;
+    return arr;
+}
+
+void segarray_destroy(segmented_array_t *arr)
+{
+    for (size_t i = 0; i < arr->chunk_count; i++)
+    {
+        free((void *) arr->chunks[i]);
+    }
+    free((void *) arr->chunks);
+    free(arr);
+}
+
+bool segarray_push(segmented_array_t *arr, void *element)
+{
+    size_t chunk = arr->size >> SEGARRAY_CHUNK_BITS;
+    if (chunk == arr->chunk_count && segarray_add_chunk(arr) == FALSE)
+    {
+        return FALSE;
+    }
+    arr->chunks[chunk][arr->size & SEGARRAY_CHUNK_MASK] = element;
+    arr->size++;
+    return TRUE;
+}
+
+void *segarray_pop(segmented_array_t *arr)
+{
+    if (arr->size == ZERO)
+    {
+        return NULL;
+    }
+    arr->size--;
+    void *element = arr->chunks[arr->size >> SEGARRAY_CHUNK_BITS][arr->size & SEGARRAY_CHUNK_MASK];
+
+    // Keep one spare chunk past the last used one so push/pop on a boundary does not thrash
+    size_t used_chunks = (arr->size + SEGARRAY_CHUNK_MASK) >> SEGARRAY_CHUNK_BITS;
+    while (arr->chunk_count > used_chunks + ONE)
+    {
+        free((void *) arr->chunks[--arr->chunk_count]);
+    }
+    return element;
+}
+
+void **segarray_slot(const segmented_array_t *arr, size_t index)
+{
+    if (index >= arr->size)
+    {
+        return NULL;
+    }
+    return &arr->chunks[index >> SEGARRAY_CHUNK_BITS][index & SEGARRAY_CHUNK_MASK];
+}
+
+void *segarray_get(const segmented_array_t *arr, size_t index)
+{
+    void **slot = segarray_slot(arr, index);
+    if (slot == NULL)
+    {
+        return NULL;
+    }
+    return *slot;
+}
+
+bool segarray_set(segmented_array_t *arr, size_t index, void *element)
+{
+    void **slot = segarray_slot(arr, index);
+    if (slot == NULL)
+    {
+        return FALSE;
+    }
+    *slot = element;
+    return TRUE;
+}
+
+size_t segarray_size(const segmented_array_t *arr)
+{
+    return arr->size;
+}
+
+bool segarray_is_empty(const segmented_array_t *arr)
+{
+    return arr->size == ZERO;
+}
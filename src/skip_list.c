@@ -0,0 +1,243 @@
+/**
+ * @file skip_list.c
+ * @brief Indexable skip list with span counts
+ *
+ * Positions are 1-based inside this file: the head sentinel is position 0 and element i of
+ * the public API sits at position i + 1. A NULL link spans to the virtual position len + 1.
+ */
+
+#include "skip_list.h"
+
+#include <stdlib.h>
+
+#define SKIPLIST_RNG_SEED 0x9E3779B97F4A7C15ULL
+
+static skip_node_t *skiplist_new_node(void *value, size_t level)
+{
+    skip_node_t *node = malloc(sizeof(skip_node_t) + level * sizeof(skip_link_t));
+    check_mem_alloc(node, "Skip list node");
+    node->value = value;
+    node->level = level;
+    return node;
+}
+
+static size_t skiplist_random_level(skip_list_t *list)
+{
+    size_t level = ONE;
+    while (level < SKIPLIST_MAX_LEVEL)
+    {
+        list->rng ^= list->rng << 13U;
+        list->rng ^= list->rng >> 7U;
+        list->rng ^= list->rng << 17U;
+        if (list->rng % SKIPLIST_P_INVERSE != 0)
+        {
+            break;
+        }
+        level++;
+    }
+    return level;
+}
+
+/*
+ * @brief For every level, the last node before position target and that node's position.
+ * O(log n) expected
+ */
+static void skiplist_find_prev(const skip_list_t *list,
+                               size_t             target,
+                               skip_node_t      **update,
+                               size_t            *rank)
+{
+    skip_node_t *node = list->head;
+    size_t       pos  = ZERO;
+    for (size_t i = list->level; i-- > 0;)
+    {
+        while (node->links[i].next != NULL && pos + node->links[i].span < target)
+        {
+            pos += node->links[i].span;
+            node = node->links[i].next;
+        }
+        update[i] = node;
+        rank[i]   = pos;
+    }
+}
+
+/*
+ * @brief Raise the list to level, the new head links span the whole list. O(levels)
+ */
+static void skiplist_raise(skip_list_t *list, size_t level, skip_node_t **update, size_t *rank)
+{
+    for (size_t i = list->level; i < level; i++)
+    {
+        list->head->links[i].next = NULL;
+        list->head->links[i].span = list->len + ONE;
+        update[i]                 = list->head;
+        rank[i]                   = ZERO;
+    }
+    list->level = level;
+}
+
+/*
+ * @brief Unlink the node at position target and return it. O(log n) expected
+ */
+static skip_node_t *skiplist_unlink(skip_list_t *list, size_t target)
+{
+    skip_node_t *update[SKIPLIST_MAX_LEVEL] = {NULL};
+    size_t       rank[SKIPLIST_MAX_LEVEL]   = {ZERO};
+    skiplist_find_prev(list, target, update, rank);
+
+    skip_node_t *node = update[0]->links[0].next;
+    for (size_t i = 0; i < list->level; i++)
+    {
+        if (update[i]->links[i].next == node)
+        {
+            update[i]->links[i].span += node->links[i].span - ONE;
+            update[i]->links[i].next = node->links[i].next;
+        }
+        else
+        {
+            update[i]->links[i].span--;
+        }
+    }
+    while (list->level > ONE && list->head->links[list->level - ONE].next == NULL)
+    {
+        list->level--;
+    }
+    list->len--;
+    return node;
+}
+
+static void skiplist_check_index(const skip_list_t *list, size_t index)
+{
+    if (list->len == 0)
+    {
+        throw_error("EMPTY SKIP LIST");
+    }
+    if (index > list->len - (size_t) ONE)
+    {
+        throw_error("INDEX OUT OF BOUNDARIES");
+    }
+}
+
+skip_list_t *skiplist_init(void)
+{
+    skip_list_t *list = malloc(sizeof(skip_list_t));
+    check_mem_alloc(list, "Skip list init");
+    list->head  = skiplist_new_node(NULL, SKIPLIST_MAX_LEVEL);
+    list->len   = ZERO;
+    list->level = ONE;
+    list->rng   = SKIPLIST_RNG_SEED;
+
+    list->head->links[0].next = NULL;
+    list->head->links[0].span = ONE;
+    return list;
+}
+
+void skiplist_delete(skip_list_t *list)
+{
+    if (list == NULL)
+    {
+        return;
+    }
+    skip_node_t *node = list->head->links[0].next;
+    while (node != NULL)
+    {
+        skip_node_t *next = node->links[0].next;
+        free(node->value);
+        free(node);
+        node = next;
+    }
+    free(list->head);
+    free(list);
+}
+
+void skiplist_insert_node(skip_list_t *list, size_t index, void *data)
+{
+    if (index > list->len)
+    {
+        throw_error("Too much index size for the skip list");
+    }
+    skip_node_t *update[SKIPLIST_MAX_LEVEL] = {NULL};
+    size_t       rank[SKIPLIST_MAX_LEVEL]   = {ZERO};
+    skiplist_find_prev(list, index + ONE, update, rank);
+
+    size_t level = skiplist_random_level(list);
+    if (level > list->level)
+    {
+        skiplist_raise(list, level, update, rank);
+    }
+
+    // Nodes after the insertion point move one position right
+    skip_node_t *node = skiplist_new_node(data, level);
+    for (size_t i = 0; i < level; i++)
+    {
+        size_t gap               = index - rank[i];
+        node->links[i].next      = update[i]->links[i].next;
+        node->links[i].span      = update[i]->links[i].span - gap;
+        update[i]->links[i].next = node;
+        update[i]->links[i].span = gap + ONE;
+    }
+    for (size_t i = level; i < list->level; i++)
+    {
+        update[i]->links[i].span++;
+    }
+    list->len++;
+}
+
+void skiplist_push_node(skip_list_t *list, void *data)
+{
+    skiplist_insert_node(list, list->len, data);
+}
+
+void skiplist_remove_node(skip_list_t *list, size_t index)
+{
+    skiplist_check_index(list, index);
+    skip_node_t *node = skiplist_unlink(list, index + ONE);
+    free(node->value);
+    free(node);
+}
+
+void *skiplist_pop_head(skip_list_t *list)
+{
+    if (list->len == (size_t) ZERO)
+    {
+        throw_error("No elements in skip list");
+    }
+    skip_node_t *node  = skiplist_unlink(list, ONE);
+    void        *value = node->value;
+    free(node);
+    return value;
+}
+
+void *skiplist_pop_tail(skip_list_t *list)
+{
+    if (list->len == (size_t) ZERO)
+    {
+        throw_error("No elements in skip list");
+    }
+    skip_node_t *node  = skiplist_unlink(list, list->len);
+    void        *value = node->value;
+    free(node);
+    return value;
+}
+
+size_t skiplist_size(const skip_list_t *list)
+{
+    return list->len;
+}
+
+void *skiplist_get_element(const skip_list_t *list, size_t index)
+{
+    skiplist_check_index(list, index);
+    size_t       target = index + ONE;
+    skip_node_t *node   = list->head;
+    size_t       pos    = ZERO;
+    for (size_t i = list->level; i-- > 0;)
+    {
+        while (node->links[i].next != NULL && pos + node->links[i].span <= target)
+        {
+            pos += node->links[i].span;
+            node = node->links[i].next;
+        }
+    }
+    return node->value;
+}
@@ -0,0 +1,282 @@
+/**
+ * @file unrolled_list.c
+ * @brief Unrolled doubly linked list
+ */
+
+#include "unrolled_list.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+static unode_t *ulist_new_node(void)
+{
+    unode_t *node = malloc(sizeof(unode_t));
+    check_mem_alloc(node, "Unrolled list node");
+    node->prev  = NULL;
+    node->next  = NULL;
+    node->count = ZERO;
+    return node;
+}
+
+/*
+ * @brief Link new_node right after node, or as the head when node is NULL. O(1)
+ */
+static void ulist_link_after(unrolled_list_t *list, unode_t *node, unode_t *new_node)
+{
+    new_node->prev = node;
+    new_node->next = node != NULL ? node->next : list->head;
+    if (new_node->next != NULL)
+    {
+        new_node->next->prev = new_node;
+    }
+    else
+    {
+        list->tail = new_node;
+    }
+    if (node != NULL)
+    {
+        node->next = new_node;
+    }
+    else
+    {
+        list->head = new_node;
+    }
+}
+
+static void ulist_unlink(unrolled_list_t *list, unode_t *node)
+{
+    if (node->prev != NULL)
+    {
+        node->prev->next = node->next;
+    }
+    else
+    {
+        list->head = node->next;
+    }
+    if (node->next != NULL)
+    {
+        node->next->prev = node->prev;
+    }
+    else
+    {
+        list->tail = node->prev;
+    }
+    free(node);
+}
+
+/*
+ * @brief Find the node holding element index (< len), walking whole nodes from the nearer
+ * end. O(n / B)
+ */
+static unode_t *ulist_locate(const unrolled_list_t *list, size_t index, size_t *offset)
+{
+    unode_t *node = NULL;
+    if (index < list->len / 2)
+    {
+        node = list->head;
+        while (index >= node->count)
+        {
+            index -= node->count;
+            node = node->next;
+        }
+        *offset = index;
+        return node;
+    }
+    size_t from_end = list->len - index;
+    node            = list->tail;
+    while (from_end > node->count)
+    {
+        from_end -= node->count;
+        node = node->prev;
+    }
+    *offset = node->count - from_end;
+    return node;
+}
+
+/*
+ * @brief Move the upper half of a full node into a new node linked after it. O(B)
+ */
+static unode_t *ulist_split(unrolled_list_t *list, unode_t *node)
+{
+    unode_t *right = ulist_new_node();
+    size_t   keep  = node->count / 2;
+    right->count   = node->count - keep;
+    memcpy((void *) right->values,
+           (const void *) &node->values[keep],
+           right->count * sizeof(void *));
+    node->count = keep;
+    ulist_link_after(list, node, right);
+    return right;
+}
+
+/*
+ * @brief Fold the successor into node when node fell under half full and both fit. O(B)
+ */
+static void ulist_maybe_merge(unrolled_list_t *list, unode_t *node)
+{
+    unode_t *next = node->next;
+    if (next == NULL || node->count >= ULIST_NODE_CAPACITY / 2 ||
+        node->count + next->count > ULIST_NODE_CAPACITY)
+    {
+        return;
+    }
+    memcpy((void *) &node->values[node->count],
+           (const void *) next->values,
+           next->count * sizeof(void *));
+    node->count += next->count;
+    ulist_unlink(list, next);
+}
+
+unrolled_list_t *ulist_init(void)
+{
+    unrolled_list_t *list = malloc(sizeof(unrolled_list_t));
+    check_mem_alloc(list, "Unrolled list init");
+    list->head = NULL;
+    list->tail = NULL;
+    list->len  = ZERO;
+    return list;
+}
+
+void ulist_delete(unrolled_list_t *list)
+{
+    if (list == NULL)
+    {
+        return;
+    }
+    unode_t *node = list->head;
+    while (node != NULL)
+    {
+        unode_t *next = node->next;
+        for (size_t i = 0; i < node->count; i++)
+        {
+            free(node->values[i]);
+        }
+        free(node);
+        node = next;
+    }
+    free(list);
+}
+
+void ulist_push_node(unrolled_list_t *list, void *data)
+{
+    // Appends fill the tail completely instead of splitting it
+    if (list->tail == NULL || list->tail->count == ULIST_NODE_CAPACITY)
+    {
+        ulist_link_after(list, list->tail, ulist_new_node());
+    }
+    list->tail->values[list->tail->count++] = data;
+    list->len++;
+}
+
+void *ulist_pop_head(unrolled_list_t *list)
+{
+    if (list->len == (size_t) ZERO)
+    {
+        throw_error("No elements in unrolled list");
+    }
+    unode_t *node  = list->head;
+    void    *value = node->values[0];
+    node->count--;
+    memmove((void *) node->values, (const void *) &node->values[1], node->count * sizeof(void *));
+    if (node->count == ZERO)
+    {
+        ulist_unlink(list, node);
+    }
+    list->len--;
+    return value;
+}
+
+void *ulist_pop_tail(unrolled_list_t *list)
+{
+    if (list->len == (size_t) ZERO)
+    {
+        throw_error("No elements in unrolled list");
+    }
+    unode_t *node  = list->tail;
+    void    *value = node->values[--node->count];
+    if (node->count == ZERO)
+    {
+        ulist_unlink(list, node);
+    }
+    list->len--;
+    return value;
+}
+
+void ulist_insert_node(unrolled_list_t *list, size_t index, void *data)
+{
+    if (index > list->len)
+    {
+        throw_error("Too much index size for the unrolled list");
+    }
+    if (index == list->len)
+    {
+        ulist_push_node(list, data);
+        return;
+    }
+
+    size_t   offset = ZERO;
+    unode_t *node   = ulist_locate(list, index, &offset);
+    if (node->count == ULIST_NODE_CAPACITY)
+    {
+        unode_t *right = ulist_split(list, node);
+        if (offset > node->count)
+        {
+            offset -= node->count;
+            node = right;
+        }
+    }
+    memmove((void *) &node->values[offset + ONE],
+            (const void *) &node->values[offset],
+            (node->count - offset) * sizeof(void *));
+    node->values[offset] = data;
+    node->count++;
+    list->len++;
+}
+
+void ulist_remove_node(unrolled_list_t *list, size_t index)
+{
+    if (list->len == 0)
+    {
+        throw_error("EMPTY UNROLLED LIST");
+    }
+    if (index > list->len - (size_t) ONE)
+    {
+        throw_error("INDEX OUT OF BOUNDARIES");
+    }
+
+    size_t   offset = ZERO;
+    unode_t *node   = ulist_locate(list, index, &offset);
+    free(node->values[offset]);
+    node->count--;
+    memmove((void *) &node->values[offset],
+            (const void *) &node->values[offset + ONE],
+            (node->count - offset) * sizeof(void *));
+    list->len--;
+
+    if (node->count == ZERO)
+    {
+        ulist_unlink(list, node);
+        return;
+    }
+    ulist_maybe_merge(list, node);
+}
+
+size_t ulist_size(const unrolled_list_t *list)
+{
+    return list->len;
+}
+
+void *ulist_get_element(const unrolled_list_t *list, size_t index)
+{
+    if (list->len == 0)
+    {
+        throw_error("empty unrolled list");
+    }
+    if (index > list->len - 1)
+    {
+        throw_error("No index in unrolled list");
+    }
+    size_t   offset = ZERO;
+    unode_t *node   = ulist_locate(list, index, &offset);
+    return node->values[offset];
+}